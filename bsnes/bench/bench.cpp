@@ -0,0 +1,346 @@
+//bsnes-bench
+//headless benchmark runner: drives the core through libsnes with null video/audio/input
+//usage: bsnes-bench [-frames N] [-state file.bst] [-movie file.bsv] [-crc] [-idle] [-runahead N] [-sync] [-format 565|8888] [-mixed] rom.sfc | -fir
+
+#include <snes/libsnes/libsnes.hpp>
+#include <snes.hpp>
+
+#include <nall/crc32.hpp>
+#include <nall/detect.hpp>
+#include <nall/file.hpp>
+#include <nall/platform.hpp>
+#include <nall/stdint.hpp>
+#include <nall/string.hpp>
+using namespace nall;
+
+#if defined(__i386__) || defined(__amd64__)
+  #include <x86intrin.h>
+#endif
+
+#if !defined(PLATFORM_WIN)
+  #include <sys/resource.h>
+  #include <sys/time.h>
+#endif
+
+#ifndef BENCH_PROFILE
+  #define BENCH_PROFILE "unknown"
+#endif
+
+namespace Bench {
+  unsigned frames = 0;
+  file movie;
+  bool movieActive = false;
+
+  //optional running checksum of all video and audio output, for verifying that a change is bit-exact
+  bool checksum = false;
+  uint32_t videoCRC = ~0, audioCRC = ~0;
+
+  //frames are rendered into videoBuffer unless the format is RGB555
+  unsigned videoFormat = SNES_VIDEO_FORMAT_RGB555;
+  uint32_t videoBuffer[512 * 478];
+  //frames are not normalized: hash each line at its own width
+  bool mixedWidths = false;
+
+  void video_refresh(const uint16_t *data, unsigned width, unsigned height) {
+    frames++;
+    if(checksum == false) return;
+    unsigned bytes = videoFormat == SNES_VIDEO_FORMAT_XRGB8888 ? 4 : 2;
+    unsigned pitch = (height >= 240 ? 512 : 1024) * bytes;
+    for(unsigned y = 0; y < height; y++) {
+      const uint8_t *line = (const uint8_t*)data + y * pitch;
+      unsigned lineWidth = mixedWidths ? snes_get_video_line_width(height >= 240 ? y >> 1 : y) : width;
+      for(unsigned x = 0; x < lineWidth * bytes; x++) videoCRC = crc32_adjust(videoCRC, line[x]);
+    }
+  }
+
+  void audio_sample_batch(const int16_t *data, unsigned frames) {
+    if(checksum == false) return;
+    for(unsigned n = 0; n < frames * 2; n++) {
+      uint16_t sample = data[n];
+      audioCRC = crc32_adjust(audioCRC, sample);
+      audioCRC = crc32_adjust(audioCRC, sample >> 8);
+    }
+  }
+
+  void input_poll() {
+  }
+
+  int16_t input_state(bool port, unsigned device, unsigned index, unsigned id) {
+    if(movieActive == false) return 0;
+    int16_t result = movie.readl(2);
+    if(movie.end()) movieActive = false;
+    return result;
+  }
+
+  //host timestamp counter; falls back to nanoseconds where no cycle counter is available
+  uint64_t cycles() {
+    #if defined(__i386__) || defined(__amd64__)
+    return __rdtsc();
+    #elif !defined(PLATFORM_WIN)
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+    #else
+    return (uint64_t)clock();
+    #endif
+  }
+
+  double seconds() {
+    #if !defined(PLATFORM_WIN)
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+    #else
+    return (double)clock() / CLOCKS_PER_SEC;
+    #endif
+  }
+
+  //peak resident set size, in kilobytes
+  unsigned peakRSS() {
+    #if !defined(PLATFORM_WIN)
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    #if defined(PLATFORM_OSX)
+    return usage.ru_maxrss / 1024;
+    #else
+    return usage.ru_maxrss;
+    #endif
+    #else
+    return 0;
+    #endif
+  }
+
+  bool loadMovie(const char *filename) {
+    if(movie.open(filename, file::mode::read) == false) return false;
+    if(movie.size() < 32) return false;
+    if(movie.readm(4) != 0x42535631) return false;  //'BSV1'
+    movie.readl(4);  //serializer version; checked by snes_unserialize()
+    movie.readl(4);  //cartridge CRC32
+    unsigned size = movie.readl(4);
+    uint8_t *data = new uint8_t[size];
+    movie.read(data, size);
+    bool result = snes_unserialize(data, size);
+    delete[] data;
+    movieActive = result && !movie.end();
+    return result;
+  }
+
+  bool readFile(const char *filename, uint8_t *&data, unsigned &size) {
+    file fp;
+    if(fp.open(filename, file::mode::read) == false) return false;
+    size = fp.size();
+    data = new uint8_t[size];
+    fp.read(data, size);
+    fp.close();
+    return true;
+  }
+
+  //mirrors the ui-qt run-ahead mode: video comes from the last speculative frame only,
+  //audio from the real frames only (so the audio CRC must match -sync; see check-runahead.sh)
+  serializer runAheadState;
+
+  void runAhead(unsigned frames) {
+    SNES::video.set_enabled(false);
+    SNES::system.run();
+    SNES::video.set_enabled(true);
+    if(SNES::scheduler.exit_reason() != SNES::Scheduler::ExitReason::FrameEvent) return;
+
+    SNES::system.runtosave();
+    SNES::system.snapshot(runAheadState);
+
+    SNES::audio.set_enabled(false);
+    for(unsigned n = 1; n <= frames; n++) {
+      SNES::video.set_enabled(n == frames);
+      SNES::system.run();
+      if(SNES::scheduler.exit_reason() != SNES::Scheduler::ExitReason::FrameEvent) break;
+    }
+
+    //the sync is still speculative, and may even cross another frame: keep its output muted
+    SNES::video.set_enabled(false);
+    SNES::system.runtosave();
+    SNES::system.restore(runAheadState);
+    SNES::video.set_enabled(true);
+    SNES::audio.set_enabled(true);
+  }
+
+  //the real timeline of runAhead() without the speculative frames. with the cycle-exact DSP
+  //running as its own thread (accuracy profile), the save point sync itself perturbs audio,
+  //so this rather than a plain run is the baseline -runahead audio must match
+  void syncFrame() {
+    SNES::system.run();
+    if(SNES::scheduler.exit_reason() != SNES::Scheduler::ExitReason::FrameEvent) return;
+
+    SNES::system.runtosave();
+    SNES::system.snapshot(runAheadState);
+    SNES::system.restore(runAheadState);
+  }
+
+  #if defined(PROFILE_COMPATIBILITY) || defined(PROFILE_PERFORMANCE)
+  //the echo FIR as the alt DSP ran it before it became one batched pass: per tap, with each
+  //coefficient read from its register, as clocks 22-25 did
+  void firScalar(const int16_t *hist, const uint8_t *regs, int *out) {
+    int sum[2];
+    for(unsigned ch = 0; ch < 2; ch++) {
+      #define tap(i) ((hist[(i) * 2 + ch] * (int8_t)regs[0x0f + (i) * 0x10]) >> 6)
+      int s = tap(0);
+      s += tap(1) + tap(2);
+      s += tap(3) + tap(4) + tap(5);
+      s += tap(6);
+      s = (int16_t)s;
+      s += (int16_t)tap(7);
+      #undef tap
+      if((int16_t)s != s) s = (s >> 31) ^ 0x7fff;
+      sum[ch] = s & ~1;
+    }
+    out[0] = sum[0], out[1] = sum[1];
+  }
+
+  //times SPC_DSP::echo_fir() against firScalar() over pseudo-random history and coefficients
+  void firBenchmark() {
+    enum { Samples = 10000000 };
+    int16_t hist[32];
+    uint8_t regs[128] = {0};
+    int16_t fir[16];
+    uint32_t seed = 1;
+    for(unsigned n = 0; n < 32; n++) seed = seed * 1103515245 + 12345, hist[n] = (int16_t)(seed >> 8) >> 1;
+    for(unsigned n = 0; n < 8; n++) {
+      seed = seed * 1103515245 + 12345;
+      regs[0x0f + n * 0x10] = seed >> 24;
+      fir[n * 2 + 0] = fir[n * 2 + 1] = (int8_t)regs[0x0f + n * 0x10];
+    }
+
+    //the history window slides, so that neither loop can be hoisted
+    int out[2];
+    uint32_t scalarSum = 0, batchedSum = 0;
+    uint64_t start = cycles();
+    for(unsigned n = 0; n < Samples; n++) {
+      firScalar(hist + (n & 7) * 2, regs, out);
+      scalarSum += out[0] ^ out[1];
+    }
+    uint64_t scalarCycles = cycles() - start;
+    start = cycles();
+    for(unsigned n = 0; n < Samples; n++) {
+      SNES::SPC_DSP::echo_fir(hist + (n & 7) * 2, fir, out);
+      batchedSum += out[0] ^ out[1];
+    }
+    uint64_t batchedCycles = cycles() - start;
+
+    printf("profile:         %s\n", BENCH_PROFILE);
+    printf("fir scalar:      %.2f cycles/sample\n", (double)scalarCycles / Samples);
+    printf("fir batched:     %.2f cycles/sample\n", (double)batchedCycles / Samples);
+    printf("results:         %s\n", scalarSum == batchedSum ? "identical" : "DIFFERENT");
+  }
+  #endif
+
+  bool loadState(const char *filename) {
+    uint8_t *data;
+    unsigned size;
+    if(readFile(filename, data, size) == false) return false;
+    bool result = snes_unserialize(data, size);
+    delete[] data;
+    return result;
+  }
+}
+
+int main(int argc, char **argv) {
+  unsigned frameCount = 3600;
+  const char *romName = 0, *stateName = 0, *movieName = 0;
+  bool idleSkip = false;
+  unsigned runAheadFrames = 0;
+  bool syncFrames = false;
+
+  for(unsigned i = 1; i < argc; i++) {
+    if(!strcmp(argv[i], "-frames") && i + 1 < argc) frameCount = strtoul(argv[++i], 0, 10);
+    else if(!strcmp(argv[i], "-state") && i + 1 < argc) stateName = argv[++i];
+    else if(!strcmp(argv[i], "-movie") && i + 1 < argc) movieName = argv[++i];
+    else if(!strcmp(argv[i], "-crc")) Bench::checksum = true;
+    else if(!strcmp(argv[i], "-idle")) idleSkip = true;
+    else if(!strcmp(argv[i], "-runahead") && i + 1 < argc) runAheadFrames = strtoul(argv[++i], 0, 10);
+    else if(!strcmp(argv[i], "-sync")) syncFrames = true;
+    else if(!strcmp(argv[i], "-fir")) {
+      #if defined(PROFILE_COMPATIBILITY) || defined(PROFILE_PERFORMANCE)
+      Bench::firBenchmark();
+      return 0;
+      #else
+      print("[bsnes-bench] Error: -fir needs the alt DSP (compatibility or performance profile)\n");
+      return 1;
+      #endif
+    }
+    else if(!strcmp(argv[i], "-mixed")) Bench::mixedWidths = true;
+    else if(!strcmp(argv[i], "-format") && i + 1 < argc) {
+      i++;
+      if(!strcmp(argv[i], "565")) Bench::videoFormat = SNES_VIDEO_FORMAT_RGB565;
+      if(!strcmp(argv[i], "8888")) Bench::videoFormat = SNES_VIDEO_FORMAT_XRGB8888;
+    }
+    else romName = argv[i];
+  }
+
+  if(!romName || !frameCount) {
+    print("usage: bsnes-bench [-frames N] [-state file.bst] [-movie file.bsv] [-crc] [-idle] [-runahead N] [-sync] [-format 565|8888] [-mixed] rom.sfc | -fir\n");
+    return 1;
+  }
+
+  uint8_t *romData;
+  unsigned romSize;
+  if(Bench::readFile(romName, romData, romSize) == false) {
+    print("[bsnes-bench] Error: unable to read ", romName, "\n");
+    return 1;
+  }
+  //strip copier header
+  uint8_t *romBase = romData;
+  if((romSize & 0x7fff) == 512) romBase += 512, romSize -= 512;
+
+  snes_init();
+  //power-on state is normally randomized; keep runs reproducible
+  SNES::config().random = false;
+  SNES::config().cpu.idle_skip = idleSkip;
+  snes_set_video_refresh(Bench::video_refresh);
+  if(Bench::videoFormat != SNES_VIDEO_FORMAT_RGB555) {
+    unsigned bytes = Bench::videoFormat == SNES_VIDEO_FORMAT_XRGB8888 ? 4 : 2;
+    snes_set_video_format(Bench::videoFormat, Bench::videoBuffer, 512 * bytes);
+  }
+  snes_set_video_normalize(!Bench::mixedWidths);
+  snes_set_audio_sample_batch(Bench::audio_sample_batch);
+  snes_set_input_poll(Bench::input_poll);
+  snes_set_input_state(Bench::input_state);
+  snes_set_cartridge_basename(romName);
+  snes_load_cartridge_normal(0, romBase, romSize);
+
+  if(stateName && Bench::loadState(stateName) == false) {
+    print("[bsnes-bench] Error: unable to load state ", stateName, "\n");
+    return 1;
+  }
+  if(movieName && Bench::loadMovie(movieName) == false) {
+    print("[bsnes-bench] Error: unable to load movie ", movieName, "\n");
+    return 1;
+  }
+
+  double timeStart = Bench::seconds();
+  uint64_t cycleStart = Bench::cycles();
+  while(Bench::frames < frameCount) {
+    if(runAheadFrames) Bench::runAhead(runAheadFrames);
+    else if(syncFrames) Bench::syncFrame();
+    else snes_run();
+  }
+  //samples emulated after the last frame event (by a save point sync) are still pending
+  SNES::audio.update();
+  uint64_t cycleEnd = Bench::cycles();
+  double timeEnd = Bench::seconds();
+
+  double elapsed = timeEnd - timeStart;
+  printf("profile:         %s\n", BENCH_PROFILE);
+  printf("frames:          %u\n", Bench::frames);
+  printf("seconds:         %.3f\n", elapsed);
+  printf("frames/second:   %.2f\n", elapsed > 0 ? Bench::frames / elapsed : 0.0);
+  printf("cycles/frame:    %llu\n", (unsigned long long)((cycleEnd - cycleStart) / Bench::frames));
+  printf("peak RSS (KB):   %u\n", Bench::peakRSS());
+  if(Bench::checksum) {
+    printf("video CRC32:     %.8x\n", ~Bench::videoCRC);
+    printf("audio CRC32:     %.8x\n", ~Bench::audioCRC);
+  }
+
+  snes_unload_cartridge();
+  snes_term();
+  delete[] romData;
+  return 0;
+}
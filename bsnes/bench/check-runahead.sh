@@ -0,0 +1,33 @@
+#!/bin/sh
+#checks that run-ahead leaks no speculative audio: for each ROM, the audio CRC with
+#-runahead must equal that of a -sync run, which takes the same save point snapshots
+#usage: bench/check-runahead.sh [-frames N] [-runahead N] out/bsnes-bench-<profile> rom.sfc...
+
+frames=3600
+runahead=2
+while [ $# -gt 0 ]; do
+  case "$1" in
+    -frames) frames="$2"; shift 2;;
+    -runahead) runahead="$2"; shift 2;;
+    *) break;;
+  esac
+done
+bench="$1"
+shift
+
+audio() {
+  "$bench" -frames "$frames" -crc "$@" | sed -n 's/^audio CRC32: *//p'
+}
+
+failed=0
+for rom in "$@"; do
+  sync=`audio -sync "$rom"`
+  ahead=`audio -runahead "$runahead" "$rom"`
+  if [ "$sync" = "$ahead" ]; then
+    echo "ok       $rom ($sync)"
+  else
+    echo "MISMATCH $rom (-sync $sync, -runahead $runahead $ahead)"
+    failed=1
+  fi
+done
+exit $failed
@@ -0,0 +1,30 @@
+#!/bin/sh
+#compares the audio of the cycle-exact DSP against the alt DSP over a set of ROMs.
+#the accuracy and compatibility profiles share the cycle-exact S-CPU core and differ
+#only in the DSP and PPU, so a mismatch between them points at the alt DSP. the
+#performance profile also swaps in the alt S-CPU core, whose coarser timing shifts when
+#the SMP sees CPU port writes; its audio can differ for reasons unrelated to the DSP
+#usage: bench/compare-dsp.sh [-frames N] rom.sfc...  (run from bsnes/ after make bench-all)
+
+frames=3600
+if [ "$1" = "-frames" ]; then
+  frames="$2"
+  shift 2
+fi
+
+audio() {
+  out/bsnes-bench-$1 -frames "$frames" -crc "$2" | sed -n 's/^audio CRC32: *//p'
+}
+
+failed=0
+for rom in "$@"; do
+  exact=`audio accuracy "$rom"`
+  alt=`audio compatibility "$rom"`
+  if [ "$exact" = "$alt" ]; then
+    echo "ok       $rom ($exact)"
+  else
+    echo "MISMATCH $rom (dsp $exact, alt dsp $alt)"
+    failed=1
+  fi
+done
+exit $failed
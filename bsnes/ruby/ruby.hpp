@@ -18,6 +18,11 @@
 #include <nall/string.hpp>
 #include <nall/vector.hpp>
 
+#include <atomic>
+#if !defined(_WIN32)
+  #include <pthread.h>
+#endif
+
 namespace ruby {
 
 #include <ruby/video.hpp>
@@ -60,7 +65,15 @@ public:
   bool set(const nall::string& name, const nall::any& value);
 
   void sample(uint16_t left, uint16_t right);
+  void sample_batch(const int16_t *data, unsigned frames);  //interleaved left/right
   void clear();
+
+  //output queue fill level, for dynamic rate control: frames queued now, the most that will be
+  //queued, and how often the queue ran dry and how many frames were dropped since the last call.
+  //all of this describes only the queue: the driver's own buffer may still have been playing
+  //when the queue ran dry, so that is not a device underrun
+  void queue_status(unsigned &queued, unsigned &limit, unsigned &emptied, unsigned &dropped);
+
   AudioInterface();
   ~AudioInterface();
 
@@ -68,12 +81,36 @@ private:
   Audio *p;
 
   unsigned volume;
+  bool synchronize;
 
   //resample unit
   double hermite(double mu, double a, double b, double c, double d);
   bool   resample_enabled;
   double r_step, r_frac;
   int    r_left[4], r_right[4];
+
+  //output queue: a single-producer, single-consumer ring of left | right << 16 frames.
+  //sample() fills it, and the output thread, which owns the driver, drains it; with
+  //synchronize set, a full queue blocks sample() instead, which limits emulation speed
+  enum : unsigned { QueueSize = 8192 };
+  uint32_t queue[QueueSize];
+  std::atomic<unsigned> queue_read, queue_write;
+  std::atomic<unsigned> queue_emptied, queue_dropped;
+  std::atomic<bool> queue_clear;
+  unsigned queue_limit;
+  unsigned queue_stall;  //read position at which the output thread was found stalled
+
+  void output(uint16_t left, uint16_t right);
+
+  #if !defined(_WIN32)
+  bool wait_for_space(unsigned write);
+  pthread_t thread;
+  std::atomic<bool> thread_active;
+  static void* thread_entry(void*);
+  void thread_run();
+  #endif
+  bool start_thread();
+  bool stop_thread();
 };
 
 class InputInterface {
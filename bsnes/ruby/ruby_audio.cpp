@@ -9,10 +9,14 @@ const char *Audio::Latency = "Latency";
 
 bool AudioInterface::init() {
   if(!p) driver();
-  return p->init();
+  stop_thread();
+  if(!p->init()) return false;
+  start_thread();
+  return true;
 }
 
 void AudioInterface::term() {
+  stop_thread();
   if(p) {
     delete p;
     p = 0;
@@ -52,7 +56,13 @@ bool AudioInterface::set(const string& name, const any& value) {
     return true;
   }
 
-  return p ? p->set(name, value) : false;
+  if(name == Audio::Synchronize) synchronize = any_cast<bool>(value);
+
+  //the output thread must not use the driver while it is reconfigured
+  bool restart = stop_thread();
+  bool result = p ? p->set(name, value) : false;
+  if(restart) start_thread();
+  return result;
 }
 
 //4-tap hermite interpolation
@@ -98,7 +108,7 @@ void AudioInterface::sample(uint16_t left, uint16_t right) {
   r_right[3] = s_right;
 
   if(resample_enabled == false) {
-    if(p) p->sample(left, right);
+    output(left, right);
     return;
   }
 
@@ -106,26 +116,163 @@ void AudioInterface::sample(uint16_t left, uint16_t right) {
     int output_left  = sclamp<16>(hermite(r_frac, r_left [0], r_left [1], r_left [2], r_left [3]));
     int output_right = sclamp<16>(hermite(r_frac, r_right[0], r_right[1], r_right[2], r_right[3]));
     r_frac += r_step;
-    if(p) p->sample(output_left, output_right);
+    output(output_left, output_right);
   }
 
   r_frac -= 1.0;
 }
 
+void AudioInterface::output(uint16_t left, uint16_t right) {
+  #if !defined(_WIN32)
+  if(thread_active) {
+    unsigned write = queue_write.load(std::memory_order_relaxed);
+    if(write - queue_read.load(std::memory_order_acquire) >= queue_limit) {
+      if(!synchronize || !wait_for_space(write)) {
+        queue_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+    queue[write & (QueueSize - 1)] = left | right << 16;
+    queue_write.store(write + 1, std::memory_order_release);
+    return;
+  }
+  #endif
+  if(p) p->sample(left, right);
+}
+
+void AudioInterface::queue_status(unsigned &queued, unsigned &limit, unsigned &emptied, unsigned &dropped) {
+  queued = queue_write.load(std::memory_order_relaxed) - queue_read.load(std::memory_order_relaxed);
+  limit = queue_limit;
+  emptied = queue_emptied.exchange(0, std::memory_order_relaxed);
+  dropped = queue_dropped.exchange(0, std::memory_order_relaxed);
+}
+
+#if !defined(_WIN32)
+//wait up to 100ms for the output thread to make room. a driver that stalls for longer no longer
+//blocks emulation: frames are dropped until the output thread moves again
+bool AudioInterface::wait_for_space(unsigned write) {
+  unsigned read = queue_read.load(std::memory_order_acquire);
+  if(read == queue_stall) return false;
+  for(unsigned n = 0; n < 100; n++) {
+    usleep(1000);
+    read = queue_read.load(std::memory_order_acquire);
+    if(write - read < queue_limit) {
+      queue_stall = ~0;
+      return true;
+    }
+  }
+  queue_stall = read;
+  return false;
+}
+
+void* AudioInterface::thread_entry(void *self) {
+  ((AudioInterface*)self)->thread_run();
+  return 0;
+}
+
+void AudioInterface::thread_run() {
+  bool drained = true;
+  while(thread_active.load(std::memory_order_relaxed)) {
+    if(queue_clear.exchange(false, std::memory_order_acquire)) {
+      queue_read.store(queue_write.load(std::memory_order_acquire), std::memory_order_release);
+      p->clear();
+      drained = true;
+    }
+
+    unsigned read = queue_read.load(std::memory_order_relaxed);
+    unsigned write = queue_write.load(std::memory_order_acquire);
+    if(read == write) {
+      if(!drained) queue_emptied.fetch_add(1, std::memory_order_relaxed);
+      drained = true;
+      usleep(1000);
+      continue;
+    }
+    drained = false;
+
+    //release space in small steps, so that a blocked producer resumes promptly
+    unsigned end = read + min(write - read, 64u);
+    while(read != end) {
+      uint32_t frame = queue[read++ & (QueueSize - 1)];
+      p->sample(frame, frame >> 16);
+    }
+    queue_read.store(read, std::memory_order_release);
+  }
+}
+#endif
+
+//the driver's own buffer provides the output latency; the queue only has to cover the output
+//thread's scheduling delays, so it holds a quarter of the driver latency, to add little on top
+bool AudioInterface::start_thread() {
+  #if !defined(_WIN32)
+  if(!p || thread_active) return false;
+  unsigned frequency = 32000, latency = 60;
+  if(p->cap(Audio::Frequency)) {
+    any value = p->get(Audio::Frequency);
+    if(const unsigned *n = any_cast<unsigned>(&value)) frequency = *n;
+  }
+  if(p->cap(Audio::Latency)) {
+    any value = p->get(Audio::Latency);
+    if(const unsigned *n = any_cast<unsigned>(&value)) latency = *n;
+  }
+  queue_limit = max(256u, min((unsigned)QueueSize, frequency * latency / 4000));
+  queue_read = queue_write = 0;
+  queue_stall = ~0;
+  queue_clear = false;
+  thread_active = true;
+  if(pthread_create(&thread, 0, thread_entry, this) == 0) return true;
+  thread_active = false;
+  #endif
+  return false;
+}
+
+//returns whether the thread was running
+bool AudioInterface::stop_thread() {
+  #if !defined(_WIN32)
+  if(!thread_active) return false;
+  thread_active = false;
+  pthread_join(thread, 0);
+  //frames still queued are dropped: the driver may be the reason they were not played
+  queue_read.store(queue_write.load());
+  return true;
+  #else
+  return false;
+  #endif
+}
+
+void AudioInterface::sample_batch(const int16_t *data, unsigned frames) {
+  for(unsigned n = 0; n < frames; n++) sample(data[n * 2 + 0], data[n * 2 + 1]);
+}
+
 void AudioInterface::clear() {
   r_frac = 0;
   r_left [0] = r_left [1] = r_left [2] = r_left [3] = 0;
   r_right[0] = r_right[1] = r_right[2] = r_right[3] = 0;
+  #if !defined(_WIN32)
+  if(thread_active) {
+    queue_clear.store(true, std::memory_order_release);
+    return;
+  }
+  #endif
   if(p) p->clear();
 }
 
 AudioInterface::AudioInterface() {
   p = 0;
   volume = 100;
+  synchronize = false;
   resample_enabled = false;
   r_step = r_frac = 0;
   r_left [0] = r_left [1] = r_left [2] = r_left [3] = 0;
   r_right[0] = r_right[1] = r_right[2] = r_right[3] = 0;
+
+  queue_read = queue_write = 0;
+  queue_emptied = queue_dropped = 0;
+  queue_clear = false;
+  queue_limit = QueueSize;
+  queue_stall = ~0;
+  #if !defined(_WIN32)
+  thread_active = false;
+  #endif
 }
 
 AudioInterface::~AudioInterface() {
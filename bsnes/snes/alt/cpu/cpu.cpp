@@ -9,11 +9,11 @@ namespace SNES {
   // now using the same CPU debugger as the other CPU implementation 
   // since they were mostly identical
   #include "../../cpu/debugger/debugger.cpp"
-  CPUDebugger cpu;
+  threadlocal CPUDebugger cpu;
   #include "../../cpu/debugger/analyst.cpp"
-  CPUAnalyst cpuAnalyst(cpu, cpu.usage);
+  threadlocal CPUAnalyst cpuAnalyst(cpu, cpu.usage);
 #else
-  CPU cpu;
+  threadlocal CPU cpu;
 #endif
 
 #include "serialization.cpp"
@@ -85,6 +85,7 @@ void CPU::enter() {
 }
 
 alwaysinline void CPU::op_step() {
+  if(idle.enabled) idle_step();
   (this->*opcode_table[op_readpc()])();
 }
 
@@ -129,6 +130,7 @@ void CPU::reset() {
   regs.wai = false;
   regs.stp = false;
   update_table();
+  idle_reset();
 
   regs.pc.l = bus.read(0xfffc);
   regs.pc.h = bus.read(0xfffd);
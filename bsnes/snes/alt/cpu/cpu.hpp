@@ -16,6 +16,7 @@ public:
   debugvirtual void mmio_write(unsigned addr, uint8 data);
 
   void op_io();
+  void op_wait();
   debugvirtual uint8 op_read(unsigned addr);
   debugvirtual void op_write(unsigned addr, uint8 data);
 
@@ -44,6 +45,9 @@ private:
   nall::priority_queue<unsigned> queue;
   void queue_event(unsigned id);
   void last_cycle();
+  unsigned idle_window();
+  void idle_position(unsigned &vcounter, unsigned &hcounter);
+  void idle_clocks(unsigned clocks);
   void add_clocks(unsigned clocks);
   void scanline();
   void run_auto_joypad_poll();
@@ -148,10 +152,10 @@ private:
   // now using the same CPU debugger as the other CPU implementation 
   // since they were mostly identical
   #include "../../cpu/debugger/debugger.hpp"
-  extern CPUDebugger cpu;
+  extern threadlocal CPUDebugger cpu;
   
   #include "../../cpu/debugger/analyst.hpp"
-  extern CPUAnalyst cpuAnalyst;
+  extern threadlocal CPUAnalyst cpuAnalyst;
 #else
-  extern CPU cpu;
+  extern threadlocal CPU cpu;
 #endif
@@ -16,6 +16,12 @@ void CPU::op_io() {
   add_clocks(6);
 }
 
+//WAI: consecutive I/O cycles inside an idle window differ only in the clock count
+void CPU::op_wait() {
+  unsigned count = idle.enabled && regs.wai ? idle_window() / 6 : 0;
+  add_clocks(count > 1 ? count * 6 : 6);
+}
+
 uint8 CPU::op_read(unsigned addr) {
   regs.mdr = bus.read(addr);
   add_clocks(speed(addr));
@@ -27,6 +27,44 @@ void CPU::last_cycle() {
   }
 }
 
+//returns how many clocks can pass before the S-CPU could observe any change:
+//no interrupt, queued event or scanline edge.
+//within this window, add_clocks() is equivalent to any sequence of smaller steps.
+unsigned CPU::idle_window() {
+  if(status.irq_lock || status.nmi_pending || status.irq_pending || regs.irq) return 0;
+  if(status.nmi_transition || status.irq_transition) return 0;
+
+  unsigned clocks = min(lineclocks() - hcounter(), queue.remaining()) - 1;
+
+  if(status.hirq_enabled) {
+    if(status.irq_line) return 0;
+    unsigned cpu_time, irq_time;
+    if(status.virq_enabled) {
+      cpu_time = vcounter() * 1364 + hcounter();
+      irq_time = status.virq_pos * 1364 + status.hirq_pos * 4;
+      if(cpu_time > irq_time) irq_time += fieldlines() * 1364;
+    } else {
+      cpu_time = hcounter();
+      irq_time = status.hirq_pos * 4;
+      if(cpu_time > irq_time) irq_time += 1364;
+    }
+    clocks = min(clocks, irq_time - cpu_time);
+  } else if(status.virq_enabled) {
+    if(status.irq_line || status.irq_valid != (vcounter() == status.virq_pos)) return 0;
+  }
+
+  return clocks;
+}
+
+void CPU::idle_position(unsigned &vcounter, unsigned &hcounter) {
+  vcounter = this->vcounter();
+  hcounter = this->hcounter();
+}
+
+void CPU::idle_clocks(unsigned clocks) {
+  add_clocks(clocks);
+}
+
 void CPU::add_clocks(unsigned clocks) {
   if(status.hirq_enabled) {
     if(status.virq_enabled) {
@@ -135,24 +135,56 @@ static short const gauss [512] =
 1299,1300,1300,1301,1302,1302,1303,1303,1303,1304,1304,1304,1304,1304,1305,1305,
 };
 
-inline int SPC_DSP::interpolate( voice_t const* v )
+// Interpolates all eight voices at once, at the start of each sample (clock 0): every
+// voice's V4 of the previous sample has run by then and none has reached V3c, so these are
+// the inputs V3c sees, apart from the KON setup which V3c applies first and is mirrored here.
+// The arithmetic runs with one lane per voice, which the compiler vectorizes.
+inline void SPC_DSP::interpolate_voices()
 {
-	// Make pointers into gaussian based on fractional position between samples
-	int offset = v->interp_pos >> 4 & 0xFF;
-	short const* fwd = gauss + 255 - offset;
-	short const* rev = gauss       + offset; // mirror left half of gaussian
-	
-	int const* in = &v->buf [(v->interp_pos >> 12) + v->buf_pos];
-	int out;
-	out  = (fwd [  0] * in [0]) >> 11;
-	out += (fwd [256] * in [1]) >> 11;
-	out += (rev [256] * in [2]) >> 11;
-	out = (int16_t) out;
-	out += (rev [  0] * in [3]) >> 11;
+	int fwd0 [voice_count], fwd1 [voice_count], rev1 [voice_count], rev0 [voice_count];
+	int in0 [voice_count], in1 [voice_count], in2 [voice_count], in3 [voice_count];
+	for ( int i = 0; i < voice_count; i++ )
+	{
+		voice_t const* v = &m.voices [i];
+		int interp_pos = v->interp_pos;
+		int buf_pos    = v->buf_pos;
+		if ( v->kon_delay )
+		{
+			interp_pos = ((v->kon_delay - 1) & 3) ? 0x4000 : 0;
+			if ( v->kon_delay == 5 )
+				buf_pos = 0;
+		}
+		
+		// Make pointers into gaussian based on fractional position between samples
+		int offset = interp_pos >> 4 & 0xFF;
+		short const* fwd = gauss + 255 - offset;
+		short const* rev = gauss       + offset; // mirror left half of gaussian
+		fwd0 [i] = fwd [  0];
+		fwd1 [i] = fwd [256];
+		rev1 [i] = rev [256];
+		rev0 [i] = rev [  0];
+		
+		int const* in = &v->buf [(interp_pos >> 12) + buf_pos];
+		in0 [i] = in [0];
+		in1 [i] = in [1];
+		in2 [i] = in [2];
+		in3 [i] = in [3];
+	}
 	
-	CLAMP16( out );
-	out &= ~1;
-	return out;
+	for ( int i = 0; i < voice_count; i++ )
+	{
+		int out;
+		out  = (fwd0 [i] * in0 [i]) >> 11;
+		out += (fwd1 [i] * in1 [i]) >> 11;
+		out += (rev1 [i] * in2 [i]) >> 11;
+		out = (int16_t) out;
+		out += (rev0 [i] * in3 [i]) >> 11;
+		
+		// CLAMP16 without the branch
+		out = out < -0x8000 ? -0x8000 : out;
+		out = out >  0x7FFF ?  0x7FFF : out;
+		m.t_interp [i] = out & ~1;
+	}
 }
 
 
@@ -294,6 +326,90 @@ inline void SPC_DSP::run_envelope( voice_t* const v )
 
 //// BRR Decoding
 
+// Decodes one BRR sample from its sign-extended nybble s, given the previous two samples
+static inline int decode_brr_sample( int s, int header, int p1, int p2 )
+{
+	// Shift sample based on header
+	int const shift = header >> 4;
+	s = (s << shift) >> 1;
+	if ( shift >= 0xD ) // handle invalid range
+		s = (s >> 25) << 11; // same as: s = (s < 0 ? -0x800 : 0)
+	
+	// Apply IIR filter (8 is the most commonly used)
+	int const filter = header & 0x0C;
+	p2 >>= 1;
+	if ( filter >= 8 )
+	{
+		s += p1;
+		s -= p2;
+		if ( filter == 8 ) // s += p1 * 0.953125 - p2 * 0.46875
+		{
+			s += p2 >> 4;
+			s += (p1 * -3) >> 6;
+		}
+		else // s += p1 * 0.8984375 - p2 * 0.40625
+		{
+			s += (p1 * -13) >> 7;
+			s += (p2 * 3) >> 4;
+		}
+	}
+	else if ( filter ) // s += p1 * 0.46875
+	{
+		s += p1 >> 1;
+		s += (-p1) >> 5;
+	}
+	
+	// Adjust sample
+	CLAMP16( s );
+	return (int16_t) (s * 2);
+}
+
+// Copies the four samples at pos from the BRR cache if they were decoded from the same
+// header, nybbles and preceding samples. A block's entry is refilled when it starts.
+inline bool SPC_DSP::decode_brr_cached( voice_t const* v, int* pos, int header, int nybbles )
+{
+	// Blocks wrapping around the end of RAM are rare enough to always decode
+	if ( v->brr_addr > 0x10000 - brr_block_size )
+		return false;
+	
+	brr_cache_t* e = &brr_cache [(v->brr_addr ^ v->brr_addr >> 8) & (brr_cache_size - 1)];
+	int const group = v->brr_offset >> 1;
+	int const p1 = pos [brr_buf_size - 1];
+	int const p2 = pos [brr_buf_size - 2];
+	
+	for ( bool filled = false; ; filled = true )
+	{
+		int const* in = &e->buf [group * 4];
+		if ( e->addr == v->brr_addr && e->data [0] == header &&
+				(e->data [1 + group * 2] << 8 | e->data [2 + group * 2]) == nybbles &&
+				(group ? in [-1] : e->hist [1]) == p1 && (group ? in [-2] : e->hist [0]) == p2 )
+		{
+			for ( int i = 0; i < 4; i++ )
+				pos [brr_buf_size + i] = pos [i] = in [i];
+			return true;
+		}
+		
+		// The rest of the block was decoded from other bytes or history: evict, so that
+		// the entry is refilled the next time the block starts
+		if ( group || filled )
+		{
+			e->addr = -1;
+			return false;
+		}
+		
+		e->addr = v->brr_addr;
+		memcpy( e->data, &m.ram [v->brr_addr], brr_block_size );
+		e->hist [0] = p2;
+		e->hist [1] = p1;
+		for ( int i = 0; i < 16; i++ )
+		{
+			int s = (int16_t) (e->data [1 + i / 2] << (8 + (i & 1) * 4)) >> 12;
+			e->buf [i] = decode_brr_sample( s, e->data [0], i ? e->buf [i - 1] : p1,
+					i > 1 ? e->buf [i - 2] : i ? p1 : p2 );
+		}
+	}
+}
+
 inline void SPC_DSP::decode_brr( voice_t* v )
 {
 	// Arrange the four input nybbles in 0xABCD order for easy decoding
@@ -307,46 +423,15 @@ inline void SPC_DSP::decode_brr( voice_t* v )
 	if ( (v->buf_pos += 4) >= brr_buf_size )
 		v->buf_pos = 0;
 	
+	if ( decode_brr_cached( v, pos, header, nybbles ) )
+		return;
+	
 	// Decode four samples
 	for ( end = pos + 4; pos < end; pos++, nybbles <<= 4 )
 	{
 		// Extract nybble and sign-extend
 		int s = (int16_t) nybbles >> 12;
-		
-		// Shift sample based on header
-		int const shift = header >> 4;
-		s = (s << shift) >> 1;
-		if ( shift >= 0xD ) // handle invalid range
-			s = (s >> 25) << 11; // same as: s = (s < 0 ? -0x800 : 0)
-		
-		// Apply IIR filter (8 is the most commonly used)
-		int const filter = header & 0x0C;
-		int const p1 = pos [brr_buf_size - 1];
-		int const p2 = pos [brr_buf_size - 2] >> 1;
-		if ( filter >= 8 )
-		{
-			s += p1;
-			s -= p2;
-			if ( filter == 8 ) // s += p1 * 0.953125 - p2 * 0.46875
-			{
-				s += p2 >> 4;
-				s += (p1 * -3) >> 6;
-			}
-			else // s += p1 * 0.8984375 - p2 * 0.40625
-			{
-				s += (p1 * -13) >> 7;
-				s += (p2 * 3) >> 4;
-			}
-		}
-		else if ( filter ) // s += p1 * 0.46875
-		{
-			s += p1 >> 1;
-			s += (-p1) >> 5;
-		}
-		
-		// Adjust and write sample
-		CLAMP16( s );
-		s = (int16_t) (s * 2);
+		s = decode_brr_sample( s, header, pos [brr_buf_size - 1], pos [brr_buf_size - 2] );
 		pos [brr_buf_size] = pos [0] = s; // second copy simplifies wrap-around
 	}
 }
@@ -455,7 +540,7 @@ VOICE_CLOCK( V3c )
 	
 	// Gaussian interpolation
 	{
-		int output = interpolate( v );
+		int output = m.t_interp [v - m.voices];
 		
 		// Noise
 		if ( m.t_non & v->vbit )
@@ -598,11 +683,11 @@ VOICE_CLOCK(V9_V6_V3) { voice_V9(v); voice_V6(v+1); voice_V3(v+2); }
 // Sample in echo history buffer, where 0 is the oldest
 #define ECHO_FIR( i )       (m.echo_hist_pos [i])
 
-// Calculate FIR point for left/right channel
-#define CALC_FIR( i, ch )   ((ECHO_FIR( i + 1 ) [ch] * (int8_t) REG(fir + i * 0x10)) >> 6)
-
 #define ECHO_CLOCK( n ) inline void SPC_DSP::echo_##n()
 
+// Clock at which each FIR tap reads its coefficient
+unsigned char const SPC_DSP::fir_tap_phase [echo_hist_size] = { 22, 23, 23, 24, 24, 24, 25, 25 };
+
 inline void SPC_DSP::echo_read( int ch )
 {
 	int s = GET_LE16SA( ECHO_PTR( ch ) );
@@ -610,6 +695,12 @@ inline void SPC_DSP::echo_read( int ch )
 	ECHO_FIR( 0 ) [ch] = ECHO_FIR( 8 ) [ch] = s >> 1;
 }
 
+inline void SPC_DSP::latch_fir()
+{
+	for ( int i = 0; i < echo_hist_size; i++ )
+		m.t_fir [i * 2] = m.t_fir [i * 2 + 1] = (int8_t) REG(fir + i * 0x10);
+}
+
 ECHO_CLOCK( 22 )
 {
 	// History
@@ -619,47 +710,46 @@ ECHO_CLOCK( 22 )
 	m.t_echo_ptr = (m.t_esa * 0x100 + m.echo_offset) & 0xFFFF;
 	echo_read( 0 );
 	
-	// FIR (using l and r temporaries below helps compiler optimize)
-	int l = CALC_FIR( 0, 0 );
-	int r = CALC_FIR( 0, 1 );
-	
-	m.t_echo_in [0] = l;
-	m.t_echo_in [1] = r;
+	// Coefficients written before each tap's clock still get into t_fir (see write())
+	latch_fir();
 }
 ECHO_CLOCK( 23 )
 {
-	int l = CALC_FIR( 1, 0 ) + CALC_FIR( 2, 0 );
-	int r = CALC_FIR( 1, 1 ) + CALC_FIR( 2, 1 );
-	
-	m.t_echo_in [0] += l;
-	m.t_echo_in [1] += r;
-	
 	echo_read( 1 );
 }
-ECHO_CLOCK( 24 )
+void SPC_DSP::echo_fir( int16_t const hist [16], int16_t const fir [16], int out [2] )
 {
-	int l = CALC_FIR( 3, 0 ) + CALC_FIR( 4, 0 ) + CALC_FIR( 5, 0 );
-	int r = CALC_FIR( 3, 1 ) + CALC_FIR( 4, 1 ) + CALC_FIR( 5, 1 );
+	// All taps of both channels at once
+	int tap [echo_hist_size * 2];
+	for ( int i = 0; i < echo_hist_size * 2; i++ )
+		tap [i] = (hist [i] * fir [i]) >> 6;
 	
-	m.t_echo_in [0] += l;
-	m.t_echo_in [1] += r;
-}
-ECHO_CLOCK( 25 )
-{
-	int l = m.t_echo_in [0] + CALC_FIR( 6, 0 );
-	int r = m.t_echo_in [1] + CALC_FIR( 6, 1 );
+	int l = 0;
+	int r = 0;
+	for ( int i = 0; i < echo_hist_size - 1; i++ )
+	{
+		l += tap [i * 2];
+		r += tap [i * 2 + 1];
+	}
 	
 	l = (int16_t) l;
 	r = (int16_t) r;
 	
-	l += (int16_t) CALC_FIR( 7, 0 );
-	r += (int16_t) CALC_FIR( 7, 1 );
+	l += (int16_t) tap [14];
+	r += (int16_t) tap [15];
 	
 	CLAMP16( l );
 	CLAMP16( r );
 	
-	m.t_echo_in [0] = l & ~1;
-	m.t_echo_in [1] = r & ~1;
+	out [0] = l & ~1;
+	out [1] = r & ~1;
+}
+ECHO_CLOCK( 25 )
+{
+	int out [2];
+	echo_fir( ECHO_FIR( 1 ), m.t_fir, out );
+	m.t_echo_in [0] = out [0];
+	m.t_echo_in [1] = out [1];
 }
 inline int SPC_DSP::echo_output( int ch )
 {
@@ -757,7 +847,7 @@ V(V9_V6_V3,2) -> V(V9,2) V(V6,3) V(V3,4) */
 
 // Voice      0      1      2      3      4      5      6      7
 #define GEN_DSP_TIMING \
-PHASE( 0)  V(V5,0)V(V2,1)\
+PHASE( 0)  interpolate_voices(); V(V5,0)V(V2,1)\
 PHASE( 1)  V(V6,0)V(V3,1)\
 PHASE( 2)  V(V7_V4_V1,0)\
 PHASE( 3)  V(V8_V5_V2,0)\
@@ -781,7 +871,7 @@ PHASE(20)         V(V1,1)                            V(V7,6)V(V4,7)\
 PHASE(21)                                            V(V8,6)V(V5,7)  V(V2,0)  /* t_brr_next_addr order dependency */\
 PHASE(22)  V(V3a,0)                                  V(V9,6)V(V6,7)  echo_22();\
 PHASE(23)                                                   V(V7,7)  echo_23();\
-PHASE(24)                                                   V(V8,7)  echo_24();\
+PHASE(24)                                                   V(V8,7)\
 PHASE(25)  V(V3b,0)                                         V(V9,7)  echo_25();\
 PHASE(26)                                                            echo_26();\
 PHASE(27) misc_27();                                                 echo_27();\
@@ -819,6 +909,8 @@ void SPC_DSP::run( int clocks_remain )
 void SPC_DSP::init( void* ram_64k )
 {
 	m.ram = (uint8_t*) ram_64k;
+	for ( int i = 0; i < brr_cache_size; i++ )
+		brr_cache [i].addr = -1;
 	mute_voices( 0 );
 	disable_surround( false );
 	set_output( 0, 0 );
@@ -1023,6 +1115,28 @@ void SPC_DSP::copy_state( unsigned char** io, copy_func_t copy )
 	SPC_COPY( uint16_t, m.t_echo_ptr );
 	SPC_COPY(  uint8_t, m.t_looped );
 	
-	copier.extra();
+	// FIR coefficients latched at clock 22, which write() can leave behind the registers.
+	// Stored as an extra block, so older states (without it) still load and re-latch instead.
+	{
+		int n = echo_hist_size;
+		SPC_COPY( uint8_t, n );
+		if ( n == echo_hist_size )
+		{
+			for ( i = 0; i < echo_hist_size; i++ )
+			{
+				int c = m.t_fir [i * 2];
+				SPC_COPY( int8_t, c );
+				m.t_fir [i * 2] = m.t_fir [i * 2 + 1] = c;
+			}
+		}
+		else
+		{
+			copier.skip( n );
+			latch_fir();
+		}
+	}
+	
+	// Not part of the state: recalculated from it (only voices yet to reach V3c use it)
+	interpolate_voices();
 }
 #endif
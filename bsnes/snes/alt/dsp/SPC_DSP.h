@@ -51,6 +51,13 @@ public:
 	enum { voice_count = 8 };
 	void mute_voices( int mask );
 
+// Echo filter
+
+	// Runs the 8-tap echo FIR for one sample of both channels. hist holds the 8 newest
+	// echo samples, oldest first, interleaved left/right, and fir the coefficient for each
+	// of them. Sets out to the filtered pair. Used by run(); public for benchmarking.
+	static void echo_fir( BOOST::int16_t const hist [16], BOOST::int16_t const fir [16], int out [2] );
+
 // State
 	
 	// Resets DSP and uses supplied values to initialize registers
@@ -122,13 +129,29 @@ public:
 private:
 	enum { brr_block_size = 9 };
 	
+	static unsigned char const fir_tap_phase [echo_hist_size];
+	
+	// Decoded BRR blocks, indexed by address. Four samples of an entry are only used when
+	// the inputs they were decoded from (header, two data bytes and the two samples before
+	// them) match what the DSP is decoding, so no invalidation on APU RAM writes is needed.
+	enum { brr_cache_size = 256 };
+	struct brr_cache_t
+	{
+		int addr;               // -1 = unused
+		uint8_t data [brr_block_size];
+		int hist [2];           // two samples before the block, most recent last
+		int buf [16];
+	};
+	brr_cache_t brr_cache [brr_cache_size];
+	
 	struct state_t
 	{
 		uint8_t regs [register_count];
 		
 		// Echo history keeps most recent 8 samples (twice the size to simplify wrap handling)
-		int echo_hist [echo_hist_size * 2] [2];
-		int (*echo_hist_pos) [2]; // &echo_hist [0 to 7]
+		// 16 bits wide (samples are 15 bits) so the FIR multiplies vectorize, see echo_25()
+		int16_t echo_hist [echo_hist_size * 2] [2];
+		int16_t (*echo_hist_pos) [2]; // &echo_hist [0 to 7]
 		
 		int every_other_sample; // toggles every sample
 		int kon;                // KON value when last checked
@@ -169,11 +192,13 @@ private:
 		int t_output;
 		int t_looped;
 		int t_echo_ptr;
+		int t_interp [voice_count]; // gaussian interpolation of each voice, see interpolate_voices()
 		
 		// left/right sums
 		int t_main_out [2];
 		int t_echo_out [2];
 		int t_echo_in  [2];
+		int16_t t_fir [echo_hist_size * 2]; // coefficient of each tap as of the clock it's read, per channel
 		
 		voice_t voices [voice_count];
 		
@@ -191,9 +216,10 @@ private:
 	void run_counters();
 	unsigned read_counter( int rate );
 	
-	int  interpolate( voice_t const* v );
+	void interpolate_voices();
 	void run_envelope( voice_t* const v );
 	void decode_brr( voice_t* v );
+	bool decode_brr_cached( voice_t const* v, int* pos, int header, int nybbles );
 
 	void misc_27();
 	void misc_28();
@@ -218,11 +244,11 @@ private:
 	void voice_V9_V6_V3( voice_t* const );
 
 	void echo_read( int ch );
+	void latch_fir();
 	int  echo_output( int ch );
 	void echo_write( int ch );
 	void echo_22();
 	void echo_23();
-	void echo_24();
 	void echo_25();
 	void echo_26();
 	void echo_27();
@@ -261,6 +287,12 @@ inline void SPC_DSP::write( int addr, int data )
 		m.outx_buf = (uint8_t) data;
 		break;
 	
+	case 0x0F:
+		// FIR coefficients are latched at clock 22; taps read later still see new writes
+		if ( m.phase > 22 && m.phase <= fir_tap_phase [addr >> 4] )
+			m.t_fir [(addr >> 4) * 2] = m.t_fir [(addr >> 4) * 2 + 1] = (int8_t) data;
+		break;
+	
 	case 0x0C:
 		if ( addr == r_kon )
 			m.new_kon = (uint8_t) data;
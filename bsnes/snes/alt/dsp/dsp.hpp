@@ -33,7 +33,7 @@ private:
 
 #if defined(DEBUGGER)
   #include "../../dsp/debugger/debugger.hpp"
-  extern DSPDebugger dsp;
+  extern threadlocal DSPDebugger dsp;
 #else
-  extern DSP dsp;
+  extern threadlocal DSP dsp;
 #endif
@@ -5,9 +5,9 @@ namespace SNES {
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.cpp"
-  PPUDebugger ppu;
+  threadlocal PPUDebugger ppu;
 #else
-  PPU ppu;
+  threadlocal PPU ppu;
 #endif
 
 #include "memory/memory.cpp"
@@ -403,20 +403,6 @@ PPU::PPU() {
     }
   }
 
-  for(unsigned l = 0; l < 16; l++) {
-    for(unsigned r = 0; r < 32; r++) {
-      for(unsigned g = 0; g < 32; g++) {
-        for(unsigned b = 0; b < 32; b++) {
-          double luma = (double)l / 15.0;
-          unsigned ar = (luma * r + 0.5);
-          unsigned ag = (luma * g + 0.5);
-          unsigned ab = (luma * b + 0.5);
-          light_table[l][(r << 10) + (g << 5) + b] = (ab << 10) + (ag << 5) + ar;
-        }
-      }
-    }
-  }
-
   layer_enabled[BG1][0] = true;
   layer_enabled[BG1][1] = true;
   layer_enabled[BG2][0] = true;
@@ -50,7 +50,6 @@ public:
   alwaysinline bool overscan()  const { return display.overscan;  }
   alwaysinline bool hires()     const { return (regs.pseudo_hires || regs.bg_mode == 5 || regs.bg_mode == 6); }
 
-  uint16 light_table[16][32768];
   uint16 mosaic_table[16][4096];
   void render_line();
 
@@ -80,7 +79,7 @@ public:
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.hpp"
-  extern PPUDebugger ppu;
+  extern threadlocal PPUDebugger ppu;
 #else
-  extern PPU ppu;
+  extern threadlocal PPU ppu;
 #endif
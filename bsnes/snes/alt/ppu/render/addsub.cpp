@@ -1,24 +1,55 @@
 #ifdef PPU_CPP
 
-//color addition / subtraction
+//color addition / subtraction for one screen over a whole line
 //thanks go to blargg for the optimized algorithms
-inline uint16 PPU::addsub(uint32 x, uint32 y, bool halve) {
-  if(!regs.color_mode) {
-    if(!halve) {
-      unsigned sum = x + y;
-      unsigned carry = (sum - ((x ^ y) & 0x0421)) & 0x8420;
-      return (sum - carry) | (carry - (carry >> 5));
-    } else {
-      return (x + y - ((x ^ y) & 0x0421)) >> 1;
-    }
-  } else {
-    unsigned diff = x - y + 0x8420;
-    unsigned borrow = (diff - ((x ^ y) & 0x8420)) & 0x8420;
-    if(!halve) {
-      return   (diff - borrow) & (borrow - (borrow >> 5));
+//main is the screen being output and sub the one it blends with (exchanged for the hires
+//subscreen pixels). every term fits in 16 bits, and conditions are applied as masks rather
+//than branches, so that the compiler can vectorize the loop
+template<bool subtract>
+inline void PPU::render_line_addsub(uint16 *output, const uint16 *src_main, const uint16 *src_sub,
+                                    const uint8 *bg_main, const uint8 *ce_main, const uint8 *bg_sub) {
+  const uint8 *window_main = window[COL].main;
+  const uint8 *window_sub  = window[COL].sub;
+
+  //the fixed color is blended in place of the subscreen unless addsub_mode is set
+  const uint16 sub_mask    = regs.addsub_mode ? 0xffff : 0x0000;
+  const uint16 fixed_color = regs.addsub_mode ? 0x0000 : regs.color_rgb;
+  //blending with the subscreen backdrop is never halved; 0xff matches no layer
+  const uint8  back_sub    = regs.addsub_mode ? BACK : 0xff;
+  const bool   color_halve = regs.color_halve;
+
+  const bool enabled_bg1  = regs.color_enabled[BG1];
+  const bool enabled_bg2  = regs.color_enabled[BG2];
+  const bool enabled_bg3  = regs.color_enabled[BG3];
+  const bool enabled_bg4  = regs.color_enabled[BG4];
+  const bool enabled_oam  = regs.color_enabled[OAM];
+  const bool enabled_back = regs.color_enabled[BACK];
+
+  for(unsigned i = 0; i < 256; i++) {
+    uint8 bg = bg_main[i];
+    bool enabled = ((bg == BG1) & enabled_bg1) | ((bg == BG2) & enabled_bg2) | ((bg == BG3) & enabled_bg3)
+                 | ((bg == BG4) & enabled_bg4) | ((bg == OAM) & enabled_oam) | ((bg == BACK) & enabled_back);
+
+    //with the main color window closed, the main color is black; with both closed, so is the pixel
+    uint16 main_window = -(uint16)window_main[i];
+    uint16 math  = -(uint16)(enabled & !ce_main[i] & window_sub[i]);
+    uint16 halve = -(uint16)(color_halve & (bg_sub[i] != back_sub)) & main_window;
+
+    uint16 x = src_main[i] & main_window;
+    uint16 y = (src_sub[i] & sub_mask) | fixed_color;
+    uint16 full, half;
+    if(!subtract) {
+      uint16 sum = x + y;
+      uint16 carry = (sum - ((x ^ y) & 0x0421)) & 0x8420;
+      full = (sum - carry) | (carry - (carry >> 5));
+      half = (uint16)(sum - ((x ^ y) & 0x0421)) >> 1;
     } else {
-      return (((diff - borrow) & (borrow - (borrow >> 5))) & 0x7bde) >> 1;
+      uint16 diff = x - y + 0x8420;
+      uint16 borrow = (diff - ((x ^ y) & 0x8420)) & 0x8420;
+      full = (diff - borrow) & (borrow - (borrow >> 5));
+      half = (full & 0x7bde) >> 1;
     }
+    output[i] = (x & ~math) | (((full & ~halve) | (half & halve)) & math);
   }
 }
 
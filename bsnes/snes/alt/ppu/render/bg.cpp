@@ -36,19 +36,19 @@ uint16 PPU::bg_get_tile(uint16 x, uint16 y) {
 }
 
 #define setpixel_main(x) \
-  if(pixel_cache[x].pri_main < tile_pri) { \
-    pixel_cache[x].pri_main = tile_pri; \
-    pixel_cache[x].bg_main  = bg; \
-    pixel_cache[x].src_main = col; \
-    pixel_cache[x].ce_main  = false; \
+  if(pixel_cache.pri_main[x] < tile_pri) { \
+    pixel_cache.pri_main[x] = tile_pri; \
+    pixel_cache.bg_main[x]  = bg; \
+    pixel_cache.src_main[x] = col; \
+    pixel_cache.ce_main[x]  = false; \
   }
 
 #define setpixel_sub(x) \
-  if(pixel_cache[x].pri_sub < tile_pri) { \
-    pixel_cache[x].pri_sub = tile_pri; \
-    pixel_cache[x].bg_sub  = bg; \
-    pixel_cache[x].src_sub = col; \
-    pixel_cache[x].ce_sub  = false; \
+  if(pixel_cache.pri_sub[x] < tile_pri) { \
+    pixel_cache.pri_sub[x] = tile_pri; \
+    pixel_cache.bg_sub[x]  = bg; \
+    pixel_cache.src_sub[x] = col; \
+    pixel_cache.ce_sub[x]  = false; \
   }
 
 template<unsigned mode, unsigned bg, unsigned color_depth>
@@ -104,6 +104,7 @@ void PPU::render_line_bg(uint8 pri0_pos, uint8 pri1_pos) {
   build_window_tables(bg);
   const uint8 *wt_main = window[bg].main;
   const uint8 *wt_sub  = window[bg].sub;
+  if((!bg_enabled || window[bg].main_full) && (!bgsub_enabled || window[bg].sub_full)) return;
 
   uint16 prev_x = 0xffff, prev_y = 0xffff, prev_optx = 0xffff;
   for(uint16 x = 0; x < width; x++) {
@@ -1,47 +1,24 @@
 #ifdef PPU_CPP
 
-#define render_bg_tile_line_2bpp(mask) \
-  col  = !!(d0 & mask) << 0; \
-  col += !!(d1 & mask) << 1; \
-  *dest++ = col
-
-#define render_bg_tile_line_4bpp(mask) \
-  col  = !!(d0 & mask) << 0; \
-  col += !!(d1 & mask) << 1; \
-  col += !!(d2 & mask) << 2; \
-  col += !!(d3 & mask) << 3; \
-  *dest++ = col
-
-#define render_bg_tile_line_8bpp(mask) \
-  col  = !!(d0 & mask) << 0; \
-  col += !!(d1 & mask) << 1; \
-  col += !!(d2 & mask) << 2; \
-  col += !!(d3 & mask) << 3; \
-  col += !!(d4 & mask) << 4; \
-  col += !!(d5 & mask) << 5; \
-  col += !!(d6 & mask) << 6; \
-  col += !!(d7 & mask) << 7; \
-  *dest++ = col
+//each row is decoded eight pixels at a time: bg_tile_planes[] spreads a bitplane byte
+//over the bytes of a row (leftmost pixel first), and the bitplanes are shifted into place
+#define render_bg_tile_line(row) \
+  memcpy(dest, &row, 8); \
+  dest += 8
 
 template<unsigned color_depth>
 void PPU::render_bg_tile(uint16 tile_num) {
-  uint8 col, d0, d1, d2, d3, d4, d5, d6, d7;
+  const uint64 *planes = bg_tile_planes;
+  uint64 row;
 
   if(color_depth == COLORDEPTH_4) {
     uint8 *dest = (uint8*)bg_tiledata[TILE_2BIT] + tile_num * 64;
     unsigned pos = tile_num * 16;
     unsigned y = 8;
     while(y--) {
-      d0 = memory::vram[pos    ];
-      d1 = memory::vram[pos + 1];
-      render_bg_tile_line_2bpp(0x80);
-      render_bg_tile_line_2bpp(0x40);
-      render_bg_tile_line_2bpp(0x20);
-      render_bg_tile_line_2bpp(0x10);
-      render_bg_tile_line_2bpp(0x08);
-      render_bg_tile_line_2bpp(0x04);
-      render_bg_tile_line_2bpp(0x02);
-      render_bg_tile_line_2bpp(0x01);
+      row  = planes[memory::vram[pos    ]];
+      row |= planes[memory::vram[pos + 1]] << 1;
+      render_bg_tile_line(row);
       pos += 2;
     }
     bg_tiledata_state[TILE_2BIT][tile_num] = 0;
@@ -52,18 +29,11 @@ void PPU::render_bg_tile(uint16 tile_num) {
     unsigned pos = tile_num * 32;
     unsigned y = 8;
     while(y--) {
-      d0 = memory::vram[pos     ];
-      d1 = memory::vram[pos +  1];
-      d2 = memory::vram[pos + 16];
-      d3 = memory::vram[pos + 17];
-      render_bg_tile_line_4bpp(0x80);
-      render_bg_tile_line_4bpp(0x40);
-      render_bg_tile_line_4bpp(0x20);
-      render_bg_tile_line_4bpp(0x10);
-      render_bg_tile_line_4bpp(0x08);
-      render_bg_tile_line_4bpp(0x04);
-      render_bg_tile_line_4bpp(0x02);
-      render_bg_tile_line_4bpp(0x01);
+      row  = planes[memory::vram[pos     ]];
+      row |= planes[memory::vram[pos +  1]] << 1;
+      row |= planes[memory::vram[pos + 16]] << 2;
+      row |= planes[memory::vram[pos + 17]] << 3;
+      render_bg_tile_line(row);
       pos += 2;
     }
     bg_tiledata_state[TILE_4BIT][tile_num] = 0;
@@ -74,31 +44,22 @@ void PPU::render_bg_tile(uint16 tile_num) {
     unsigned pos = tile_num * 64;
     unsigned y = 8;
     while(y--) {
-      d0 = memory::vram[pos     ];
-      d1 = memory::vram[pos +  1];
-      d2 = memory::vram[pos + 16];
-      d3 = memory::vram[pos + 17];
-      d4 = memory::vram[pos + 32];
-      d5 = memory::vram[pos + 33];
-      d6 = memory::vram[pos + 48];
-      d7 = memory::vram[pos + 49];
-      render_bg_tile_line_8bpp(0x80);
-      render_bg_tile_line_8bpp(0x40);
-      render_bg_tile_line_8bpp(0x20);
-      render_bg_tile_line_8bpp(0x10);
-      render_bg_tile_line_8bpp(0x08);
-      render_bg_tile_line_8bpp(0x04);
-      render_bg_tile_line_8bpp(0x02);
-      render_bg_tile_line_8bpp(0x01);
+      row  = planes[memory::vram[pos     ]];
+      row |= planes[memory::vram[pos +  1]] << 1;
+      row |= planes[memory::vram[pos + 16]] << 2;
+      row |= planes[memory::vram[pos + 17]] << 3;
+      row |= planes[memory::vram[pos + 32]] << 4;
+      row |= planes[memory::vram[pos + 33]] << 5;
+      row |= planes[memory::vram[pos + 48]] << 6;
+      row |= planes[memory::vram[pos + 49]] << 7;
+      render_bg_tile_line(row);
       pos += 2;
     }
     bg_tiledata_state[TILE_8BIT][tile_num] = 0;
   }
 }
 
-#undef render_bg_tile_line_2bpp
-#undef render_bg_tile_line_4bpp
-#undef render_bg_tile_line_8bpp
+#undef render_bg_tile_line
 
 void PPU::flush_pixel_cache() {
   uint16 main = get_palette(0);
@@ -108,14 +69,14 @@ void PPU::flush_pixel_cache() {
 
   unsigned i = 255;
   do {
-    pixel_cache[i].src_main = main;
-    pixel_cache[i].src_sub  = sub;
-    pixel_cache[i].bg_main  = BACK;
-    pixel_cache[i].bg_sub   = BACK;
-    pixel_cache[i].ce_main  = false;
-    pixel_cache[i].ce_sub   = false;
-    pixel_cache[i].pri_main = 0;
-    pixel_cache[i].pri_sub  = 0;
+    pixel_cache.src_main[i] = main;
+    pixel_cache.src_sub[i]  = sub;
+    pixel_cache.bg_main[i]  = BACK;
+    pixel_cache.bg_sub[i]   = BACK;
+    pixel_cache.ce_main[i]  = false;
+    pixel_cache.ce_sub[i]   = false;
+    pixel_cache.pri_main[i] = 0;
+    pixel_cache.pri_sub[i]  = 0;
   } while(i--);
 }
 
@@ -126,6 +87,13 @@ void PPU::alloc_tiledata_cache() {
   bg_tiledata_state[TILE_2BIT] = new uint8_t[  4096]();
   bg_tiledata_state[TILE_4BIT] = new uint8_t[  2048]();
   bg_tiledata_state[TILE_8BIT] = new uint8_t[  1024]();
+
+  //built bytewise, so that memcpy() of an entry yields the same row on any host byte order
+  for(unsigned n = 0; n < 256; n++) {
+    uint8 row[8];
+    for(unsigned x = 0; x < 8; x++) row[x] = (n >> (7 - x)) & 1;
+    memcpy(&bg_tile_planes[n], row, 8);
+  }
 }
 
 //marks all tiledata cache entries as dirty
@@ -20,9 +20,6 @@ void PPU::render_line_mode7(uint8 pri0_pos, uint8 pri1_pos) {
 
   if(regs.bg_enabled[bg] == false && regs.bgsub_enabled[bg] == false) return;
 
-  int32 px, py;
-  int32 tx, ty, tile, palette;
-
   int32 a = sclip<16>(cache.m7a);
   int32 b = sclip<16>(cache.m7b);
   int32 c = sclip<16>(cache.m7c);
@@ -33,13 +30,13 @@ void PPU::render_line_mode7(uint8 pri0_pos, uint8 pri1_pos) {
   int32 hofs = sclip<13>(cache.m7_hofs);
   int32 vofs = sclip<13>(cache.m7_vofs);
 
-  int  _pri, _x;
   bool _bg_enabled    = regs.bg_enabled[bg];
   bool _bgsub_enabled = regs.bgsub_enabled[bg];
 
   build_window_tables(bg);
   uint8 *wt_main = window[bg].main;
   uint8 *wt_sub  = window[bg].sub;
+  if((!_bg_enabled || window[bg].main_full) && (!_bgsub_enabled || window[bg].sub_full)) return;
 
   int32 y = (regs.mode7_vflip == false ? regs.bg_y[bg] : 255 - regs.bg_y[bg]);
 
@@ -47,84 +44,75 @@ void PPU::render_line_mode7(uint8 pri0_pos, uint8 pri1_pos) {
 
   int32 psx = ((a * CLIP(hofs - cx)) & ~63) + ((b * CLIP(vofs - cy)) & ~63) + ((b * y) & ~63) + (cx << 8);
   int32 psy = ((c * CLIP(hofs - cx)) & ~63) + ((d * CLIP(vofs - cy)) & ~63) + ((d * y) & ~63) + (cy << 8);
-  for(int32 x = 0; x < 256; x++) {
-    px = psx + (a * mtable[x]);
-    py = psy + (c * mtable[x]);
 
+  //the whole line is transformed and fetched in passes; every pass but the two VRAM reads
+  //is branch-free, so the compiler vectorizes them
+  const uint8 *vram = &memory::vram[0];
+  const int16 a16 = a, c16 = c;  //16x16-bit products (mtable entries are < 4096)
+  uint16 addr[256];
+  uint8 tile[256], fine[256], inside[256], pixel[256];
+  for(unsigned x = 0; x < 256; x++) {
     //mask floating-point bits (low 8 bits)
-    px >>= 8;
-    py >>= 8;
-
-    switch(regs.mode7_repeat) {
-      case 0:    //screen repetition outside of screen area
-      case 1: {  //same as case 0
-        px &= 1023;
-        py &= 1023;
-        tx = ((px >> 3) & 127);
-        ty = ((py >> 3) & 127);
-        tile    = memory::vram[(ty * 128 + tx) << 1];
-        palette = memory::vram[(((tile << 6) + ((py & 7) << 3) + (px & 7)) << 1) + 1];
-      } break;
-      case 2: {  //palette color 0 outside of screen area
-        if((px | py) & ~1023) {
-          palette = 0;
-        } else {
-          px &= 1023;
-          py &= 1023;
-          tx = ((px >> 3) & 127);
-          ty = ((py >> 3) & 127);
-          tile    = memory::vram[(ty * 128 + tx) << 1];
-          palette = memory::vram[(((tile << 6) + ((py & 7) << 3) + (px & 7)) << 1) + 1];
-        }
-      } break;
-      case 3: {  //character 0 repetition outside of screen area
-        if((px | py) & ~1023) {
-          tile = 0;
-        } else {
-          px &= 1023;
-          py &= 1023;
-          tx = ((px >> 3) & 127);
-          ty = ((py >> 3) & 127);
-          tile = memory::vram[(ty * 128 + tx) << 1];
-        }
-        palette = memory::vram[(((tile << 6) + ((py & 7) << 3) + (px & 7)) << 1) + 1];
-      } break;
-    }
+    int32 px = (psx + a16 * (int16)mtable[x]) >> 8;
+    int32 py = (psy + c16 * (int16)mtable[x]) >> 8;
+    addr[x] = ((((py >> 3) & 127) << 7) + ((px >> 3) & 127)) << 1;
+    fine[x] = ((py & 7) << 3) + (px & 7);
+    inside[x] = ((px | py) & ~1023) ? 0x00 : 0xff;
+  }
+  for(unsigned x = 0; x < 256; x++) tile[x] = vram[addr[x]];
+  //repeat 0, 1: screen repetition outside of screen area
+  //repeat 3: character 0 repetition outside of screen area
+  if(regs.mode7_repeat == 3) {
+    for(unsigned x = 0; x < 256; x++) tile[x] &= inside[x];
+  }
+  for(unsigned x = 0; x < 256; x++) {
+    addr[x] = (((tile[x] << 6) + fine[x]) << 1) + 1;
+  }
+  for(unsigned x = 0; x < 256; x++) pixel[x] = vram[addr[x]];
+  //repeat 2: palette color 0 outside of screen area
+  if(regs.mode7_repeat == 2) {
+    for(unsigned x = 0; x < 256; x++) pixel[x] &= inside[x];
+  }
 
-    if(bg == BG1) {
-      _pri = pri0_pos;
-    } else {
+  //resolve priority and color of every pixel, in screen order; priority 0 never wins below
+  const bool hflip = regs.mode7_hflip;
+  const bool direct_color = regs.direct_color == true && bg == BG1;
+  uint8 pri[256];
+  uint16 col[256];
+  for(unsigned x = 0; x < 256; x++) {
+    unsigned palette = pixel[hflip == false ? x : 255 - x];
+    unsigned _pri = pri0_pos;
+    if(bg == BG2) {
       _pri = (palette >> 7) ? pri1_pos : pri0_pos;
       palette &= 0x7f;
     }
 
-    if(!palette) continue;
-
-    _x = (regs.mode7_hflip == false) ? (x) : (255 - x);
-
-    uint32 col;
-    if(regs.direct_color == true && bg == BG1) {
-      //direct color mode does not apply to bg2, as it is only 128 colors...
-      col = get_direct_color(0, palette);
-    } else {
-      col = get_palette(palette);
-    }
+    pri[x] = palette ? _pri : 0;
+    //direct color mode does not apply to bg2, as it is only 128 colors...
+    col[x] = direct_color ? get_direct_color(0, palette) : get_palette(palette);
+  }
 
-    if(regs.bg_enabled[bg] == true && !wt_main[_x]) {
-      if(pixel_cache[_x].pri_main < _pri) {
-        pixel_cache[_x].pri_main = _pri;
-        pixel_cache[_x].bg_main  = bg;
-        pixel_cache[_x].src_main = col;
-        pixel_cache[_x].ce_main  = false;
-      }
+  if(_bg_enabled) {
+    for(unsigned x = 0; x < 256; x++) {
+      //branch-free setpixel: all-ones masks where this layer's pixel is above the cached one
+      bool above = !wt_main[x] & (pixel_cache.pri_main[x] < pri[x]);
+      uint8 mask = -above;
+      uint16 mask16 = -above;
+      pixel_cache.pri_main[x] = (pixel_cache.pri_main[x] & ~mask) | (pri[x] & mask);
+      pixel_cache.bg_main[x]  = (pixel_cache.bg_main[x]  & ~mask) | (bg & mask);
+      pixel_cache.src_main[x] = (pixel_cache.src_main[x] & ~mask16) | (col[x] & mask16);
+      pixel_cache.ce_main[x]  &= ~mask;
     }
-    if(regs.bgsub_enabled[bg] == true && !wt_sub[_x]) {
-      if(pixel_cache[_x].pri_sub < _pri) {
-        pixel_cache[_x].pri_sub = _pri;
-        pixel_cache[_x].bg_sub  = bg;
-        pixel_cache[_x].src_sub = col;
-        pixel_cache[_x].ce_sub  = false;
-      }
+  }
+  if(_bgsub_enabled) {
+    for(unsigned x = 0; x < 256; x++) {
+      bool above = !wt_sub[x] & (pixel_cache.pri_sub[x] < pri[x]);
+      uint8 mask = -above;
+      uint16 mask16 = -above;
+      pixel_cache.pri_sub[x] = (pixel_cache.pri_sub[x] & ~mask) | (pri[x] & mask);
+      pixel_cache.bg_sub[x]  = (pixel_cache.bg_sub[x]  & ~mask) | (bg & mask);
+      pixel_cache.src_sub[x] = (pixel_cache.src_sub[x] & ~mask16) | (col[x] & mask16);
+      pixel_cache.ce_sub[x]  &= ~mask;
     }
   }
 }
@@ -186,18 +186,18 @@ void PPU::render_line_oam_rto() {
 }
 
 #define setpixel_main(x) \
-  if(pixel_cache[x].pri_main < pri) { \
-    pixel_cache[x].pri_main = pri; \
-    pixel_cache[x].bg_main  = OAM; \
-    pixel_cache[x].src_main = get_palette(oam_line_pal[x]); \
-    pixel_cache[x].ce_main  = (oam_line_pal[x] < 192); \
+  if(pixel_cache.pri_main[x] < pri) { \
+    pixel_cache.pri_main[x] = pri; \
+    pixel_cache.bg_main[x]  = OAM; \
+    pixel_cache.src_main[x] = get_palette(oam_line_pal[x]); \
+    pixel_cache.ce_main[x]  = (oam_line_pal[x] < 192); \
   }
 #define setpixel_sub(x) \
-  if(pixel_cache[x].pri_sub < pri) { \
-    pixel_cache[x].pri_sub = pri; \
-    pixel_cache[x].bg_sub  = OAM; \
-    pixel_cache[x].src_sub = get_palette(oam_line_pal[x]); \
-    pixel_cache[x].ce_sub  = (oam_line_pal[x] < 192); \
+  if(pixel_cache.pri_sub[x] < pri) { \
+    pixel_cache.pri_sub[x] = pri; \
+    pixel_cache.bg_sub[x]  = OAM; \
+    pixel_cache.src_sub[x] = get_palette(oam_line_pal[x]); \
+    pixel_cache.ce_sub[x]  = (oam_line_pal[x] < 192); \
   }
 
 void PPU::render_line_oam(uint8 pri0_pos, uint8 pri1_pos, uint8 pri2_pos, uint8 pri3_pos) {
@@ -209,17 +209,18 @@ void PPU::render_line_oam(uint8 pri0_pos, uint8 pri1_pos, uint8 pri2_pos, uint8
 
   if(regs.bg_enabled[OAM] == false && regs.bgsub_enabled[OAM] == false) return;
 
-  for(unsigned s = 0; s < 34; s++) {
-    if(oam_tilelist[s].tile == 0xffff) continue;
-    render_oam_tile(s);
-  }
-
   bool bg_enabled    = regs.bg_enabled[OAM];
   bool bgsub_enabled = regs.bgsub_enabled[OAM];
 
   build_window_tables(OAM);
   uint8 *wt_main = window[OAM].main;
   uint8 *wt_sub  = window[OAM].sub;
+  if((!bg_enabled || window[OAM].main_full) && (!bgsub_enabled || window[OAM].sub_full)) return;
+
+  for(unsigned s = 0; s < 34; s++) {
+    if(oam_tilelist[s].tile == 0xffff) continue;
+    render_oam_tile(s);
+  }
 
   unsigned pri_tbl[4] = { pri0_pos, pri1_pos, pri2_pos, pri3_pos };
   for(int x = 0; x < 256; x++) {
@@ -12,21 +12,23 @@ inline void render_line_mode7();
 enum { COLORDEPTH_4 = 0, COLORDEPTH_16 = 1, COLORDEPTH_256 = 2 };
 enum { TILE_2BIT = 0, TILE_4BIT = 1, TILE_8BIT = 2 };
 
-struct pixel_t {
+struct pixel_cache_t {
+  //one array per field, so that render_line_output() can process a whole line at a time
   //bgr555 color data for main/subscreen pixels: 0x0000 = transparent / use palette color # 0
   //needs to be bgr555 instead of palette index for direct color mode ($2130 bit 0) to work
-  uint16 src_main, src_sub;
+  uint16 src_main[256], src_sub[256];
   //indicates source of palette # for main/subscreen (BG1-4, OAM, or back)
-  uint8  bg_main,  bg_sub;
+  uint8  bg_main[256],  bg_sub[256];
   //color_exemption -- true when bg == OAM && palette index >= 192, disables color add/sub effects
-  uint8  ce_main,  ce_sub;
+  uint8  ce_main[256],  ce_sub[256];
   //priority level of src_n. to set src_n,
   //the priority of the pixel must be >pri_n
-  uint8  pri_main, pri_sub;
-} pixel_cache[256];
+  uint8  pri_main[256], pri_sub[256];
+} pixel_cache;
 
 uint8 *bg_tiledata[3];
 uint8 *bg_tiledata_state[3];  //0 = valid, 1 = dirty
+uint64 bg_tile_planes[256];   //bitplane byte -> one bit per pixel byte of a row
 
 template<unsigned color_depth> void render_bg_tile(uint16 tile_num);
 inline void flush_pixel_cache();
@@ -37,10 +39,12 @@ void free_tiledata_cache();
 //windows.cpp
 struct window_t {
   uint8 main[256], sub[256];
+  bool main_full, sub_full;  //every pixel of the table is set
 } window[6];
 
 void build_window_table(uint8 bg, bool mainscreen);
 void build_window_tables(uint8 bg);
+void build_window_mask(WindowMask &mask, uint8 bg);
 
 //bg.cpp
 struct {
@@ -88,12 +92,11 @@ void render_line_oam(uint8 pri0_pos, uint8 pri1_pos, uint8 pri2_pos, uint8 pri3_
 template<unsigned bg> void render_line_mode7(uint8 pri0_pos, uint8 pri1_pos);
 
 //addsub.cpp
-inline uint16 addsub(uint32 x, uint32 y, bool halve);
+template<bool subtract> inline void render_line_addsub(uint16 *output, const uint16 *src_main, const uint16 *src_sub,
+                                                       const uint8 *bg_main, const uint8 *ce_main, const uint8 *bg_sub);
 
 //line.cpp
 inline uint16 get_palette(uint8 index);
 inline uint16 get_direct_color(uint8 p, uint8 t);
-inline uint16 get_pixel_normal(uint32 x);
-inline uint16 get_pixel_swap(uint32 x);
 void   render_line_output();
 void   render_line_clear();
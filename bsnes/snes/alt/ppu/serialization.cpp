@@ -133,14 +133,14 @@ void PPU::serialize(serializer &s) {
   s.integer(regs.oam_tilecount);
 
   for(unsigned n = 0; n < 256; n++) {
-    s.integer(pixel_cache[n].src_main);
-    s.integer(pixel_cache[n].src_sub);
-    s.integer(pixel_cache[n].bg_main);
-    s.integer(pixel_cache[n].bg_sub);
-    s.integer(pixel_cache[n].ce_main);
-    s.integer(pixel_cache[n].ce_sub);
-    s.integer(pixel_cache[n].pri_main);
-    s.integer(pixel_cache[n].pri_sub);
+    s.integer(pixel_cache.src_main[n]);
+    s.integer(pixel_cache.src_sub[n]);
+    s.integer(pixel_cache.bg_main[n]);
+    s.integer(pixel_cache.bg_sub[n]);
+    s.integer(pixel_cache.ce_main[n]);
+    s.integer(pixel_cache.ce_sub[n]);
+    s.integer(pixel_cache.pri_main[n]);
+    s.integer(pixel_cache.pri_sub[n]);
   }
 
   //better to just take a small speed hit than store all of bg_tiledata[3][] ...
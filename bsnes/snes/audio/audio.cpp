@@ -1,6 +1,6 @@
 #ifdef SYSTEM_CPP
 
-Audio audio;
+threadlocal Audio audio;
 
 Stream::Stream() {
   audio_init();
@@ -10,59 +10,111 @@ void Stream::audio_init() {
   stream_.rdoffset = 0;
   stream_.wroffset = 0;
   stream_.length = 0;
+  stream_.input_length = 0;
 
   stream_.r_sum_l = stream_.r_sum_r = 0;
-  stream_.r_step = 1.0;
+  stream_.r_step = 1ull << 32;
+  stream_.r_scale = 1 << 16;
   stream_.r_frac = 0;
 }
 
-bool Stream::has_sample() {
-  return stream_.length > 0;
-}
-
-uint32 Stream::get_sample() {
-  uint32 sample_ = stream_.buffer[stream_.rdoffset];
-  stream_.rdoffset = (stream_.rdoffset + 1) & 32767;
-  stream_.length--;
-  return sample_;
+void Stream::audio_mix(int *left, int *right, unsigned count) {
+  for(unsigned n = 0; n < count; n++) {
+    uint32 sample_ = stream_.buffer[(stream_.rdoffset + n) & 32767];
+    left[n]  += (int16)(sample_ >>  0);
+    right[n] += (int16)(sample_ >> 16);
+  }
+  stream_.rdoffset = (stream_.rdoffset + count) & 32767;
+  stream_.length -= count;
 }
 
 void Stream::audio_frequency(double input_frequency) {
+  //samples still pending were taken at the previous frequency
+  if(stream_.input_length) audio_resample();
+
   double output_frequency;
   output_frequency = system.apu_frequency() / 768.0;
-  stream_.r_step = input_frequency / output_frequency;
+  //one input sample can produce at most one output sample
+  stream_.r_step = max(1ull << 32, (uint64)(input_frequency / output_frequency * 4294967296.0 + 0.5));
+  stream_.r_scale = (1ull << 48) / stream_.r_step;
   stream_.r_frac = 0;
 }
 
 void Stream::sample(int16 left, int16 right) {
+  if(!audio.enabled()) return;
   if(dsp.mute()) left = 0, right = 0;
 
-  if(stream_.r_frac >= 1.0) {
-    stream_.r_frac -= 1.0;
-    stream_.r_sum_l += left;
-    stream_.r_sum_r += right;
-    return;
-  }
+  stream_.input_l[stream_.input_length] = left;
+  stream_.input_r[stream_.input_length] = right;
+  if(++stream_.input_length < InputBlock) return;
+
+  audio_resample();
+  audio.flush();
+}
+
+void Stream::audio_resample() {
+  const uint64 step = stream_.r_step;
+  const int64 scale = stream_.r_scale;
+  uint64 frac = stream_.r_frac;
+  int64 sum_l = stream_.r_sum_l;
+  int64 sum_r = stream_.r_sum_r;
+
+  for(unsigned n = 0; n < stream_.input_length;) {
+    //input samples entirely within the current output sample are summed as a run
+    unsigned whole = frac >> 32;
+    if(whole) {
+      unsigned count = min(whole, stream_.input_length - n);
+      int run_l = 0, run_r = 0;
+      for(unsigned i = 0; i < count; i++) {
+        run_l += stream_.input_l[n + i];
+        run_r += stream_.input_r[n + i];
+      }
+      sum_l += (int64)run_l << 16;
+      sum_r += (int64)run_r << 16;
+      frac -= (uint64)count << 32;
+      n += count;
+      continue;
+    }
 
-  stream_.r_sum_l += left  * stream_.r_frac;
-  stream_.r_sum_r += right * stream_.r_frac;
+    //this sample straddles two output samples; split it by the fraction left
+    int left  = stream_.input_l[n];
+    int right = stream_.input_r[n];
+    unsigned weight = frac >> 16;
+    n++;
 
-  uint16 output_left  = sclamp<16>(int(stream_.r_sum_l / stream_.r_step));
-  uint16 output_right = sclamp<16>(int(stream_.r_sum_r / stream_.r_step));
+    sum_l += (int64)left  * weight;
+    sum_r += (int64)right * weight;
 
-  double first = 1.0 - stream_.r_frac;
-  stream_.r_sum_l = left  * first;
-  stream_.r_sum_r = right * first;
-  stream_.r_frac = stream_.r_step - first;
+    uint16 output_left  = sclamp<16>((sum_l * scale) >> 32);
+    uint16 output_right = sclamp<16>((sum_r * scale) >> 32);
 
-  stream_.buffer[stream_.wroffset] = (output_left << 0) + (output_right << 16);
-  stream_.wroffset = (stream_.wroffset + 1) & 32767;
-  stream_.length = (stream_.length + 1) & 32767;
-  audio.flush();
+    sum_l = (int64)left  * (65536 - weight);
+    sum_r = (int64)right * (65536 - weight);
+    frac = step - ((1ull << 32) - frac);
+
+    stream_.buffer[stream_.wroffset] = (output_left << 0) + (output_right << 16);
+    stream_.wroffset = (stream_.wroffset + 1) & 32767;
+    stream_.length = (stream_.length + 1) & 32767;
+  }
+
+  stream_.r_frac = frac;
+  stream_.r_sum_l = sum_l;
+  stream_.r_sum_r = sum_r;
+  stream_.input_length = 0;
+}
+
+Audio::Audio() {
+  enabled_ = true;
+  output_length = 0;
+}
+
+void Audio::set_enabled(bool enabled) {
+  enabled_ = enabled;
 }
 
 void Audio::init() {
   streams.reset();
+  output_length = 0;
 
   dsp_rdoffset = 0;
   dsp_wroffset = 0;
@@ -78,9 +130,16 @@ void Audio::add_stream(Stream* stream) {
   streams.append(stream);
 }
   
+void Audio::output(int16 left, int16 right) {
+  output_buffer[output_length * 2 + 0] = left;
+  output_buffer[output_length * 2 + 1] = right;
+  if(++output_length == OutputBlock) update();
+}
+
 void Audio::sample(int16 left, int16 right) {
+  if(!enabled_) return;
   if(!streams.size()) {
-    system.interface->audio_sample(left, right);
+    output(left, right);
   } else {
     dsp_buffer[dsp_wroffset] = ((uint16)left << 0) + ((uint16)right << 16);
     dsp_wroffset = (dsp_wroffset + 1) & 32767;
@@ -90,29 +149,37 @@ void Audio::sample(int16 left, int16 right) {
 }
 
 void Audio::flush() {
-  while(streams.size() && dsp_length) {
-    for(unsigned i = 0; i < streams.size(); i++) {
-      if (!streams[i]->has_sample()) return;
+  if(!streams.size()) return;
+
+  //mix as many samples as the DSP and every stream have ready, a block at a time
+  unsigned length = dsp_length;
+  for(unsigned i = 0; i < streams.size(); i++) length = min(length, streams[i]->audio_length());
+
+  int left[MixBlock], right[MixBlock];
+  while(length) {
+    unsigned count = min(length, (unsigned)MixBlock);
+    for(unsigned n = 0; n < count; n++) {
+      uint32 dsp_sample = dsp_buffer[(dsp_rdoffset + n) & 32767];
+      left[n]  = (int16)(dsp_sample >>  0);
+      right[n] = (int16)(dsp_sample >> 16);
     }
+    dsp_rdoffset = (dsp_rdoffset + count) & 32767;
+    dsp_length -= count;
 
-    uint32 dsp_sample = dsp_buffer[dsp_rdoffset];
-    dsp_rdoffset = (dsp_rdoffset + 1) & 32767;
-    dsp_length--;
-
-    int left  = (int16)(dsp_sample >>  0);
-    int right = (int16)(dsp_sample >> 16);
+    for(unsigned i = 0; i < streams.size(); i++) streams[i]->audio_mix(left, right, count);
 
-    for(unsigned i = 0; i < streams.size(); i++) {
-      uint32 sample = streams[i]->get_sample();
-      left  += (int16)(sample >> 0);
-      right += (int16)(sample >> 16);
+    for(unsigned n = 0; n < count; n++) {
+      output(sclamp<16>(left[n] / 2), sclamp<16>(right[n] / 2));
     }
-
-    system.interface->audio_sample(
-      sclamp<16>(left / 2),
-      sclamp<16>(right / 2)
-    );
+    length -= count;
   }
 }
 
+//called at the end of every frame
+void Audio::update() {
+  if(!output_length) return;
+  system.interface->audio_sample_batch(output_buffer, output_length);
+  output_length = 0;
+}
+
 #endif
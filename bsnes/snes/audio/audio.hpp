@@ -2,22 +2,34 @@ class Stream {
 public:
   Stream();
   void audio_init();
-  alwaysinline bool has_sample();
-  alwaysinline uint32 get_sample();
+  alwaysinline unsigned audio_length() const { return stream_.length; }
+  void audio_mix(int *left, int *right, unsigned count);
 
 protected:
   void audio_frequency(double frequency);
   void sample(int16 left, int16 right);
 
 private:
+  void audio_resample();
+
+  //input samples are collected and resampled a block at a time
+  enum { InputBlock = 64 };
+
   struct {
     uint32 buffer[32768];
     unsigned rdoffset;
     unsigned wroffset;
     unsigned length;
 
-    double r_step, r_frac;
-    int r_sum_l, r_sum_r;
+    int16 input_l[InputBlock];
+    int16 input_r[InputBlock];
+    unsigned input_length;
+
+    //every output sample is the average of r_step input samples;
+    //positions are 32.32 fixed point, sums are weighted by 16-bit fractions
+    uint64 r_step, r_frac;
+    int64 r_scale;  //2^48 / r_step
+    int64 r_sum_l, r_sum_r;
   } stream_;
 };
 
@@ -27,14 +39,31 @@ public:
   void add_stream(Stream* stream);
   void sample(int16 left, int16 right);
   void flush();
+  void update();
+
+  //output can be suppressed, eg for frames that are emulated speculatively;
+  //samples produced meanwhile by the DSP and by all streams are dropped
+  void set_enabled(bool);
+  alwaysinline bool enabled() const { return enabled_; }
+  Audio();
 
 private:
+  enum { MixBlock = 256 };
+  enum { OutputBlock = 1024 };
+
+  alwaysinline void output(int16 left, int16 right);
+
+  bool enabled_;
   uint32 dsp_buffer[32768];
   unsigned dsp_rdoffset;
   unsigned dsp_wroffset;
   unsigned dsp_length;
 
+  //final samples, passed to the interface in batches
+  int16_t output_buffer[OutputBlock * 2];
+  unsigned output_length;
+
   linear_vector<Stream*> streams;
 };
 
-extern Audio audio;
+extern threadlocal Audio audio;
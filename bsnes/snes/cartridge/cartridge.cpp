@@ -10,22 +10,23 @@ namespace SNES {
 #include "serialization.cpp"
 
 namespace memory {
-  MappedRAM cartrom, cartram, cartrtc;
-  MappedRAM bsxpack, bsxpram;
-  MappedRAM stArom, stAram;
-  MappedRAM stBrom, stBram;
-  MappedRAM gbrom, gbram, gbrtc;
+  threadlocal MappedRAM cartrom, cartram, cartrtc;
+  threadlocal MappedRAM bsxpack, bsxpram;
+  threadlocal MappedRAM stArom, stAram;
+  threadlocal MappedRAM stBrom, stBram;
+  threadlocal MappedRAM gbrom, gbram, gbrtc;
 };
 
-Cartridge cartridge;
+threadlocal Cartridge cartridge;
 
 int Cartridge::rom_offset(unsigned addr) const {
   Bus::Page &page = bus.page[addr >> 8];
-  if (page.access == &memory::cartrom ||
-      page.access == &memory::cx4rom ||
-      page.access == &memory::gsurom ||
-      page.access == &memory::fxrom ||
-      page.access == &memory::vsprom) {
+  Memory *access = &cheat.source(*page.access);
+  if (access == &memory::cartrom ||
+      access == &memory::cx4rom ||
+      access == &memory::gsurom ||
+      access == &memory::fxrom ||
+      access == &memory::vsprom) {
     return page.offset + addr;
   }
   
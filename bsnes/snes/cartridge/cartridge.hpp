@@ -116,11 +116,11 @@ private:
 };
 
 namespace memory {
-  extern MappedRAM cartrom, cartram, cartrtc;
-  extern MappedRAM bsxpack, bsxpram;
-  extern MappedRAM stArom, stAram;
-  extern MappedRAM stBrom, stBram;
-  extern MappedRAM gbrom, gbram, gbrtc;
+  extern threadlocal MappedRAM cartrom, cartram, cartrtc;
+  extern threadlocal MappedRAM bsxpack, bsxpram;
+  extern threadlocal MappedRAM stArom, stAram;
+  extern threadlocal MappedRAM stBrom, stBram;
+  extern threadlocal MappedRAM gbrom, gbram, gbrtc;
 };
 
-extern Cartridge cartridge;
+extern threadlocal Cartridge cartridge;
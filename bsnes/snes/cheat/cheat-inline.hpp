@@ -1,2 +1,14 @@
 bool Cheat::active() const { return cheat_enabled; }
-bool Cheat::exists(uint16 addr) const { return bitmask[addr >> 3] & 1 << (addr & 7); }
+
+Memory* Cheat::overlay(Memory &access, unsigned offset) const {
+  if(page_count == 0) return 0;
+  for(CheatPage *page = page_hash[(offset >> 8) & 255]; page; page = page->next) {
+    if(page->access == &access && page->offset == offset) return page;
+  }
+  return 0;
+}
+
+Memory& Cheat::source(Memory &access) const {
+  if(&access >= page_list && &access < page_list + page_count) return *((CheatPage&)access).access;
+  return access;
+}
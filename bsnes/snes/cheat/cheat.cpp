@@ -3,7 +3,7 @@
 #define CHEAT_CPP
 namespace SNES {
 
-Cheat cheat;
+threadlocal Cheat cheat;
 
 bool Cheat::enabled() const {
   return system_enabled;
@@ -11,47 +11,116 @@ bool Cheat::enabled() const {
 
 void Cheat::enable(bool state) {
   system_enabled = state;
-  cheat_enabled = system_enabled && code_enabled;
+  synchronize();
 }
 
+//rebuilds the overlay pages for all enabled codes and remaps every bus to use them.
+//a code applies to every page (on any bus) mirroring the memory its address maps to
 void Cheat::synchronize() {
-  memset(bitmask, 0x00, sizeof bitmask);
-  code_enabled = false;
+  //coprocessor buses are only mapped (by their chip's power/reset) when the cartridge has that chip;
+  //otherwise they may still hold a previous cartridge's mapping
+  Bus *buses[5];
+  unsigned bus_count = 0;
+  buses[bus_count++] = &bus;
+  if(cartridge.has_sa1()) {
+    buses[bus_count++] = &sa1bus;
+    buses[bus_count++] = &vbrbus;
+  }
+  if(cartridge.has_superfx()) buses[bus_count++] = &superfxbus;
+  if(cartridge.has_cx4()) buses[bus_count++] = &cx4bus;
 
+  unsigned codes = 0;
   for(unsigned i = 0; i < size(); i++) {
     const CheatCode &code = operator[](i);
-    if(code.enabled == false) continue;
-
-    for(unsigned n = 0; n < code.addr.size(); n++) {
-      code_enabled = true;
-
-      uint16 addr = code.addr[n];
-      bitmask[addr >> 3] |= 1 << (addr & 7);
-    }
+    if(code.enabled) codes += code.addr.size();
   }
-
+  code_enabled = codes > 0;
   cheat_enabled = system_enabled && code_enabled;
-}
 
-bool Cheat::read(unsigned addr, uint8 &data, Bus &bus) const {
-  for(unsigned i = 0; i < size(); i++) {
+  CheatPage *prior_list = page_list;
+  unsigned prior_count = page_count;
+  page_list = cheat_enabled ? new CheatPage[codes * bus_count] : 0;
+  page_count = 0;
+  memset(page_hash, 0, sizeof page_hash);
+
+  if(cheat_enabled) for(unsigned i = 0; i < size(); i++) {
     const CheatCode &code = operator[](i);
     if(code.enabled == false) continue;
 
     for(unsigned n = 0; n < code.addr.size(); n++) {
-      if(bus.is_mirror(addr, code.addr[n])) {
-        data = code.data[n];
-        return true;
+      unsigned addr = code.addr[n] & 0xffffff;
+
+      for(unsigned b = 0; b < bus_count; b++) {
+        Bus::Page &p = buses[b]->page[addr >> 8];
+        if(!p.access) continue;  //bus never mapped
+
+        Memory *access = p.access;
+        if(access >= prior_list && access < prior_list + prior_count) access = ((CheatPage*)access)->access;
+        unsigned offset = p.offset + (addr & ~0xff);
+
+        CheatPage *page = (CheatPage*)overlay(*access, offset);
+        if(!page) {
+          page = &page_list[page_count++];
+          page->access = access;
+          page->offset = offset;
+          memset(page->patched, 0, sizeof page->patched);
+          page->next = page_hash[(offset >> 8) & 255];
+          page_hash[(offset >> 8) & 255] = page;
+        }
+
+        //earlier codes take precedence over later ones for the same address
+        unsigned index = addr & 0xff;
+        if(page->patched[index >> 3] & 1 << (index & 7)) continue;
+        page->patched[index >> 3] |= 1 << (index & 7);
+        page->data[index] = code.data[n];
       }
     }
   }
 
-  return false;
+  for(unsigned b = 0; b < bus_count; b++) remap(*buses[b], prior_list, prior_count);
+  delete[] prior_list;
+}
+
+void Cheat::remap(Bus &bus, CheatPage *prior_list, unsigned prior_count) {
+  for(unsigned n = 0; n < 65536; n++) {
+    Bus::Page &p = bus.page[n];
+    if(!p.access) continue;
+
+    Memory *access = p.access;
+    if(access >= prior_list && access < prior_list + prior_count) access = ((CheatPage*)access)->access;
+    bus.map(n << 8, *access, p.offset + (n << 8));
+  }
 }
 
 Cheat::Cheat() {
   system_enabled = true;
-  synchronize();
+  code_enabled = false;
+  cheat_enabled = false;
+  page_list = 0;
+  page_count = 0;
+  memset(page_hash, 0, sizeof page_hash);
+}
+
+Cheat::~Cheat() {
+  delete[] page_list;
+}
+
+//=========
+//CheatPage
+//=========
+
+unsigned CheatPage::size() const {
+  return access->size();
+}
+
+uint8 CheatPage::read(unsigned addr) {
+  unsigned index = addr - offset;
+  if(index < 256 && patched[index >> 3] & 1 << (index & 7)) return data[index];
+  return access->read(addr);
+}
+
+void CheatPage::write(unsigned addr, uint8 data) {
+  access->write(addr, data);
 }
 
 //===============
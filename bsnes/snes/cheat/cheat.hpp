@@ -7,6 +7,21 @@ struct CheatCode {
   CheatCode();
 };
 
+//overlay for one 256-byte page holding cheated addresses; Bus pages that map the
+//patched memory point here instead, so the bus read path has no cheat test at all.
+//patched bytes read back the code data, all other accesses go to the original memory
+struct CheatPage : Memory {
+  Memory *access;
+  unsigned offset;
+  CheatPage *next;
+  uint8 patched[32];
+  uint8 data[256];
+
+  unsigned size() const;
+  uint8 read(unsigned addr);
+  void write(unsigned addr, uint8 data);
+};
+
 class Cheat : public linear_vector<CheatCode> {
 public:
   enum class Type : unsigned { ProActionReplay, GameGenie };
@@ -14,21 +29,27 @@ public:
   bool enabled() const;
   void enable(bool);
   void synchronize();
-  bool read(unsigned, uint8&, Bus&) const;
 
   inline bool active() const;
-  inline bool exists(uint16 addr) const;
+  inline Memory* overlay(Memory &access, unsigned offset) const;
+  inline Memory& source(Memory &access) const;
 
   Cheat();
+  ~Cheat();
 
   static bool decode(const char*, unsigned&, uint8&, Type&);
   static bool encode(string&, unsigned, uint8, Type);
 
 private:
-  uint8 bitmask[0x2000];
   bool system_enabled;
   bool code_enabled;
   bool cheat_enabled;
+
+  CheatPage *page_list;
+  unsigned page_count;
+  CheatPage *page_hash[256];
+
+  void remap(Bus&, CheatPage *prior_list, unsigned prior_count);
 };
 
-extern Cheat cheat;
+extern threadlocal Cheat cheat;
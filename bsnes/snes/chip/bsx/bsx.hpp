@@ -112,6 +112,6 @@ private:
   } regs;
 };
 
-extern BSXBase  bsxbase;
-extern BSXCart  bsxcart;
-extern BSXFlash bsxflash;
+extern threadlocal BSXBase  bsxbase;
+extern threadlocal BSXCart  bsxcart;
+extern threadlocal BSXFlash bsxflash;
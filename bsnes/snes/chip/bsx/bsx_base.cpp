@@ -1,6 +1,6 @@
 #ifdef BSX_CPP
 
-BSXBase bsxbase;
+threadlocal BSXBase bsxbase;
 
 void BSXBase::Enter() { bsxbase.enter(); }
 
@@ -1,6 +1,6 @@
 #ifdef BSX_CPP
 
-BSXCart bsxcart;
+threadlocal BSXCart bsxcart;
 
 void BSXCart::init() {
 }
@@ -1,11 +1,11 @@
 #ifdef CX4_CPP
 
-Cx4Bus cx4bus;
+threadlocal Cx4Bus cx4bus;
 
 namespace memory {
-  UnmappedCx4 cx4_unmapped;
-  Cx4ROM cx4rom;
-  Cx4RAM cx4ram;
+  threadlocal UnmappedCx4 cx4_unmapped;
+  threadlocal Cx4ROM cx4rom;
+  threadlocal Cx4RAM cx4ram;
 }
 
 void Cx4Bus::init() {
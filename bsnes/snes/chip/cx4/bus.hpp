@@ -21,6 +21,6 @@ struct Cx4RAM : Memory {
 };
 
 namespace memory {
-  extern Cx4ROM cx4rom;
-  extern Cx4RAM cx4ram;
+  extern threadlocal Cx4ROM cx4rom;
+  extern threadlocal Cx4RAM cx4ram;
 }
@@ -10,7 +10,7 @@ namespace SNES {
 #include "data.cpp"
 #include "serialization.cpp"
 
-Cx4 cx4;
+threadlocal Cx4 cx4;
 
 void Cx4::Enter() { cx4.enter(); }
 
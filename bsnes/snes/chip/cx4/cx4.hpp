@@ -121,5 +121,5 @@ protected:
 
 };
 
-extern Cx4 cx4;
-extern Cx4Bus cx4bus;
+extern threadlocal Cx4 cx4;
+extern threadlocal Cx4Bus cx4bus;
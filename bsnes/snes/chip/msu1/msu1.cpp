@@ -3,7 +3,7 @@
 #define MSU1_CPP
 namespace SNES {
 
-MSU1 msu1;
+threadlocal MSU1 msu1;
 
 #include "serialization.cpp"
 
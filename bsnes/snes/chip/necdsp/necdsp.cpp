@@ -6,7 +6,7 @@ namespace SNES {
 #include "memory.cpp"
 #include "disassembler.cpp"
 #include "serialization.cpp"
-NECDSP necdsp;
+threadlocal NECDSP necdsp;
 
 void NECDSP::Enter() { necdsp.enter(); }
 
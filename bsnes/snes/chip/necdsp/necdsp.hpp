@@ -48,4 +48,4 @@ public:
   ~NECDSP();
 };
 
-extern NECDSP necdsp;
+extern threadlocal NECDSP necdsp;
@@ -1,18 +1,18 @@
 #ifdef SA1_CPP
 
-VBRBus vbrbus;
-SA1Bus sa1bus;
+threadlocal VBRBus vbrbus;
+threadlocal SA1Bus sa1bus;
 
 namespace memory {
-  StaticRAM iram(2048);
-  UnmappedSA1 sa1_unmapped;
+  threadlocal StaticRAM iram(2048);
+  threadlocal UnmappedSA1 sa1_unmapped;
                         //accessed by:
-  VSPROM vsprom;        //S-CPU + SA-1
-  CPUIRAM cpuiram;      //S-CPU
-  SA1IRAM sa1iram;      //SA-1
-  SA1BWRAM sa1bwram;    //SA-1
-  CC1BWRAM cc1bwram;    //S-CPU
-  BitmapRAM bitmapram;  //SA-1
+  threadlocal VSPROM vsprom;        //S-CPU + SA-1
+  threadlocal CPUIRAM cpuiram;      //S-CPU
+  threadlocal SA1IRAM sa1iram;      //SA-1
+  threadlocal SA1BWRAM sa1bwram;    //SA-1
+  threadlocal CC1BWRAM cc1bwram;    //S-CPU
+  threadlocal BitmapRAM bitmapram;  //SA-1
 }
 
 //$230c (VDPL), $230d (VDPH) use this bus to read variable-length data.
@@ -50,13 +50,13 @@ struct BitmapRAM : Memory {
 };
 
 namespace memory {
-  extern StaticRAM iram;
-
-  extern UnmappedSA1 sa1_unmapped;
-  extern VSPROM vsprom;
-  extern CPUIRAM cpuiram;
-  extern SA1IRAM sa1iram;
-  extern SA1BWRAM sa1bwram;
-  extern CC1BWRAM cc1bwram;
-  extern BitmapRAM bitmapram;
+  extern threadlocal StaticRAM iram;
+
+  extern threadlocal UnmappedSA1 sa1_unmapped;
+  extern threadlocal VSPROM vsprom;
+  extern threadlocal CPUIRAM cpuiram;
+  extern threadlocal SA1IRAM sa1iram;
+  extern threadlocal SA1BWRAM sa1bwram;
+  extern threadlocal CC1BWRAM cc1bwram;
+  extern threadlocal BitmapRAM bitmapram;
 };
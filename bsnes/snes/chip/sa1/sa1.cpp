@@ -5,11 +5,11 @@ namespace SNES {
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.cpp"
-  SA1Debugger sa1;
+  threadlocal SA1Debugger sa1;
   #include "../../cpu/debugger/analyst.cpp"
-  CPUAnalyst sa1Analyst(sa1, sa1.usage);
+  threadlocal CPUAnalyst sa1Analyst(sa1, sa1.usage);
 #else
-  SA1 sa1;
+  threadlocal SA1 sa1;
 #endif
 
 #include "serialization.cpp"
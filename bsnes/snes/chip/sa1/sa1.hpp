@@ -40,11 +40,11 @@ public:
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.hpp"
-  extern SA1Debugger sa1;
-  extern VBRBus vbrbus;
+  extern threadlocal SA1Debugger sa1;
+  extern threadlocal VBRBus vbrbus;
   
-  extern CPUAnalyst sa1Analyst;
+  extern threadlocal CPUAnalyst sa1Analyst;
 #else
-  extern SA1 sa1;
+  extern threadlocal SA1 sa1;
 #endif
-extern SA1Bus sa1bus;
+extern threadlocal SA1Bus sa1bus;
@@ -38,4 +38,4 @@ private:
   } buffer;
 };
 
-extern SDD1 sdd1;
+extern threadlocal SDD1 sdd1;
@@ -3,7 +3,7 @@
 #define SERIAL_CPP
 namespace SNES {
 
-Serial serial;
+threadlocal Serial serial;
 
 #include "serialization.cpp"
 
@@ -56,8 +56,8 @@ void SPC7110Decomp::init(unsigned mode, unsigned offset, unsigned index) {
 //
 
 void SPC7110Decomp::mode0(bool init) {
-  static uint8 val, in, span;
-  static int out, inverts, lps, in_count;
+  static threadlocal uint8 val, in, span;
+  static threadlocal int out, inverts, lps, in_count;
 
   if(init == true) {
     out = inverts = lps = 0;
@@ -123,9 +123,9 @@ void SPC7110Decomp::mode0(bool init) {
 }
 
 void SPC7110Decomp::mode1(bool init) {
-  static int pixelorder[4], realorder[4];
-  static uint8 in, val, span;
-  static int out, inverts, lps, in_count;
+  static threadlocal int pixelorder[4], realorder[4];
+  static threadlocal uint8 in, val, span;
+  static threadlocal int out, inverts, lps, in_count;
 
   if(init == true) {
     for(unsigned i = 0; i < 4; i++) pixelorder[i] = i;
@@ -226,10 +226,10 @@ void SPC7110Decomp::mode1(bool init) {
 }
 
 void SPC7110Decomp::mode2(bool init) {
-  static int pixelorder[16], realorder[16];
-  static uint8 bitplanebuffer[16], buffer_index;
-  static uint8 in, val, span;
-  static int out0, out1, inverts, lps, in_count;
+  static threadlocal int pixelorder[16], realorder[16];
+  static threadlocal uint8 bitplanebuffer[16], buffer_index;
+  static threadlocal uint8 in, val, span;
+  static threadlocal int out0, out1, inverts, lps, in_count;
 
   if(init == true) {
     for(unsigned i = 0; i < 16; i++) pixelorder[i] = i;
@@ -3,10 +3,10 @@
 #define SPC7110_CPP
 namespace SNES {
 
-SPC7110 spc7110;
-SPC7110MCU spc7110mcu;
-SPC7110DCU spc7110dcu;
-SPC7110RAM spc7110ram;
+threadlocal SPC7110 spc7110;
+threadlocal SPC7110MCU spc7110mcu;
+threadlocal SPC7110DCU spc7110dcu;
+threadlocal SPC7110RAM spc7110ram;
 
 #include "serialization.cpp"
 #include "decomp.cpp"
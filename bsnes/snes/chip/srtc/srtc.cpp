@@ -3,7 +3,7 @@
 #define SRTC_CPP
 namespace SNES {
 
-SRTC srtc;
+threadlocal SRTC srtc;
 
 #include "serialization.cpp"
 
@@ -3,7 +3,7 @@
 #define ST0018_CPP
 namespace SNES {
 
-ST0018 st0018;
+threadlocal ST0018 st0018;
 
 uint8 ST0018::mmio_read(unsigned addr) {
   if(addr == 0x3800) return regs.r3800;
@@ -1,12 +1,12 @@
 #ifdef SUPERFX_CPP
 
-SuperFXBus superfxbus;
+threadlocal SuperFXBus superfxbus;
 
 namespace memory {
-  SuperFXGSUROM gsurom;
-  SuperFXGSURAM gsuram;
-  SuperFXCPUROM fxrom;
-  SuperFXCPURAM fxram;
+  threadlocal SuperFXGSUROM gsurom;
+  threadlocal SuperFXGSURAM gsuram;
+  threadlocal SuperFXCPUROM fxrom;
+  threadlocal SuperFXCPURAM fxram;
 }
 
 void SuperFXBus::init() {
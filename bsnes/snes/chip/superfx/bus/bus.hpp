@@ -27,8 +27,8 @@ struct SuperFXCPURAM : Memory {
 };
 
 namespace memory {
-  extern SuperFXGSUROM gsurom;
-  extern SuperFXGSURAM gsuram;
-  extern SuperFXCPUROM fxrom;
-  extern SuperFXCPURAM fxram;
+  extern threadlocal SuperFXGSUROM gsurom;
+  extern threadlocal SuperFXGSURAM gsuram;
+  extern threadlocal SuperFXCPUROM fxrom;
+  extern threadlocal SuperFXCPURAM fxram;
 }
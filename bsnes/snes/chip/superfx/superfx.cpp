@@ -13,9 +13,9 @@ namespace SNES {
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.cpp"
-  SFXDebugger superfx;
+  threadlocal SFXDebugger superfx;
 #else
-  SuperFX superfx;
+  threadlocal SuperFX superfx;
 #endif
 
 void SuperFX::Enter() { superfx.enter(); }
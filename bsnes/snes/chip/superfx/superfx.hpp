@@ -22,8 +22,8 @@ public:
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.hpp"
-  extern SFXDebugger superfx;
+  extern threadlocal SFXDebugger superfx;
 #else
-  extern SuperFX superfx;
+  extern threadlocal SuperFX superfx;
 #endif
-extern SuperFXBus superfxbus;
+extern threadlocal SuperFXBus superfxbus;
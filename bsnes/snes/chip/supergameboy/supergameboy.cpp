@@ -5,9 +5,9 @@ namespace SNES {
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.cpp"
-  SGBDebugger supergameboy;
+  threadlocal SGBDebugger supergameboy;
 #else
-  SuperGameBoy supergameboy;
+  threadlocal SuperGameBoy supergameboy;
 #endif
 
 #include "serialization.cpp"
@@ -39,7 +39,7 @@ private:
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.hpp"
-  extern SGBDebugger supergameboy;
+  extern threadlocal SGBDebugger supergameboy;
 #else
-  extern SuperGameBoy supergameboy;
+  extern threadlocal SuperGameBoy supergameboy;
 #endif
@@ -1,7 +1,7 @@
 #ifdef SYSTEM_CPP
 
 Configuration &config() {
-  static Configuration configuration;
+  static threadlocal Configuration configuration;
   return configuration;
 }
 
@@ -18,6 +18,7 @@ Configuration::Configuration() {
   cpu.ntsc_frequency  = 21477272;  //315 / 88 * 6000000
   cpu.pal_frequency   = 21281370;
   cpu.wram_init_value = 0x55;
+  cpu.idle_skip       = false;
 
   smp.ntsc_frequency = 24607104;   //32040.5 * 768
   smp.pal_frequency  = 24607104;
@@ -12,6 +12,7 @@ struct Configuration {
     unsigned ntsc_frequency;
     unsigned pal_frequency;
     unsigned wram_init_value;
+    bool idle_skip;  //fast-forward through WAI and polling loops
   } cpu;
 
   struct SMP {
@@ -7,6 +7,7 @@ namespace SNES {
 #include "serialization.cpp"
 #include "algorithms.cpp"
 #include "disassembler/disassembler.cpp"
+#include "idle.cpp"
 
 #define L last_cycle();
 #define call(op) (this->*op)()
@@ -58,6 +59,7 @@ alwaysinline void CPUcore::op_io_cond6(uint16 addr) {
 
 CPUcore::CPUcore() {
   initialize_opcode_table();
+  idle_reset();
 }
 
 }
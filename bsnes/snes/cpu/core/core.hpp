@@ -17,6 +17,31 @@ public:
 
   virtual uint8 disassembler_read(uint32 addr);
 
+  //idle loop fast-forwarding (opt-in, see Configuration::CPU::idle_skip)
+  struct Idle {
+    bool enabled;
+    uint32 last;      //address of the previously executed opcode
+    uint32 pc;        //polling loop the snapshot below was taken in
+    uint32 branch;    //address of its branch opcode
+
+    //state at the start of the previous loop iteration
+    uint16 a, x, y;
+    uint8 p, mdr;
+    unsigned vcounter, hcounter, window;
+  } idle;
+
+  virtual void op_wait();
+  void idle_step();
+  bool idle_loop(uint32 pc, uint32 branch);
+  bool idle_source(uint32 addr);
+  void idle_reset();
+
+  //hooks for idle_step(): clocks that may pass before an event a polling loop could observe,
+  //the current position, and fast-forwarding by a number of clocks
+  virtual unsigned idle_window() { return 0; }
+  virtual void idle_position(unsigned &vcounter, unsigned &hcounter) { vcounter = hcounter = 0; }
+  virtual void idle_clocks(unsigned clocks) {}
+
   void op_io_irq();
   void op_io_cond2();
   void op_io_cond4(uint16 x, uint16 y);
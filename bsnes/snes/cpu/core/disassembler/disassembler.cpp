@@ -105,7 +105,7 @@ uint32 CPUcore::decode(uint8 offset_type, uint32 addr, uint32 pc) {
 }
 
 void CPUcore::disassemble_opcode_ex(CPUcore::Opcode &opcode, uint32 addr, bool e, bool m, bool x) {
-  static reg24_t pc;
+  static threadlocal reg24_t pc;
   pc.d = addr;
 
   uint8 param[4];
@@ -157,7 +157,7 @@ void CPUcore::disassemble_opcode_ex(CPUcore::Opcode &opcode, uint32 addr, bool e
 }
 
 void CPUcore::disassemble_opcode(char *output, uint32 addr, bool hclocks) {
-  static reg24_t pc;
+  static threadlocal reg24_t pc;
   char t[256];
   char *s = output;
 
@@ -0,0 +1,100 @@
+#ifdef CPUCORE_CPP
+
+//I/O cycle spent waiting for an interrupt in WAI;
+//the S-CPU overrides this to fast-forward through idle time
+void CPUcore::op_wait() {
+  op_io();
+}
+
+//called before each opcode when idle skipping is enabled.
+//once an iteration of a polling loop ran entirely inside an idle window and
+//left the registers as it found them, every further iteration would repeat it
+//exactly; so as many as fit in the current window are skipped at once.
+void CPUcore::idle_step() {
+  uint32 last = idle.last;
+  idle.last = regs.pc.d;
+  if(regs.pc.d == idle.branch && last == idle.pc) return;
+  if(last - regs.pc.d - 2 > 2 || !idle_loop(regs.pc.d, last)) {
+    idle.pc = idle.branch = ~0;
+    return;
+  }
+
+  unsigned vcounter, hcounter;
+  idle_position(vcounter, hcounter);
+  if(regs.pc.d == idle.pc && last == idle.branch && vcounter == idle.vcounter
+  && regs.a == idle.a && regs.x == idle.x && regs.y == idle.y && regs.p == idle.p && regs.mdr == idle.mdr) {
+    unsigned period = hcounter - idle.hcounter;
+    if(hcounter > idle.hcounter && period <= idle.window) {
+      unsigned count = idle_window() / period;
+      if(count) {
+        idle_clocks(count * period);
+        idle_position(vcounter, hcounter);
+      }
+    }
+  }
+
+  idle.pc = regs.pc.d;
+  idle.branch = last;
+  idle.a = regs.a;
+  idle.x = regs.x;
+  idle.y = regs.y;
+  idle.p = regs.p;
+  idle.mdr = regs.mdr;
+  idle.vcounter = vcounter;
+  idle.hcounter = hcounter;
+  idle.window = idle_window();
+}
+
+//recognizes a polling loop: a single LDA, LDX, LDY or BIT at pc,
+//immediately followed by a conditional branch at branch back to it.
+//the loop itself must be in ROM or RAM, so it can be inspected without side effects.
+bool CPUcore::idle_loop(uint32 pc, uint32 branch) {
+  Bus::Page &page = bus.page[pc >> 8];
+  if(!page.read_base || (pc >> 8) != ((branch + 1) >> 8)) return false;
+  const uint8 *code = page.read_base + (pc & 0xff);
+  unsigned length = branch - pc;
+
+  switch(code[length]) {
+    case 0x10: case 0x30: case 0x50: case 0x70:  //bpl, bmi, bvc, bvs
+    case 0x90: case 0xb0: case 0xd0: case 0xf0:  //bcc, bcs, bne, beq
+      break;
+    default:
+      return false;
+  }
+  if((int8)code[length + 1] != -(int)(length + 2)) return false;
+
+  uint32 addr;
+  switch(code[0]) {
+    case 0x24: case 0xa4: case 0xa5: case 0xa6:  //bit, ldy, lda, ldx dp
+      if(length != 2) return false;
+      addr = (regs.d + code[1]) & 0xffff;
+      break;
+    case 0x2c: case 0xac: case 0xad: case 0xae:  //bit, ldy, lda, ldx addr
+      if(length != 3) return false;
+      addr = (regs.db << 16) + (code[1] | code[2] << 8);
+      break;
+    case 0xaf:  //lda long
+      if(length != 4) return false;
+      addr = code[1] | code[2] << 8 | code[3] << 16;
+      break;
+    default:
+      return false;
+  }
+
+  return idle_source(addr) && idle_source((addr + 1) & 0xffffff);
+}
+
+//memory a polling loop may read while being fast-forwarded: WRAM, which only the
+//S-CPU and (H)DMA can modify, and the NMI and IRQ flags ($4210, $4211), which only
+//change on the events that bound the S-CPU's idle window.
+bool CPUcore::idle_source(uint32 addr) {
+  if(bus.page[addr >> 8].access == &memory::wram) return true;
+  return (addr & 0x40fffe) == 0x004210;
+}
+
+void CPUcore::idle_reset() {
+  idle.enabled = config().cpu.idle_skip;
+  idle.last = idle.pc = idle.branch = ~0;
+}
+
+#endif
@@ -65,7 +65,7 @@ L   op_io();
 void CPUcore::op_wai() {
   regs.wai = true;
   while(regs.wai && !scheduler.synchronizing()) {
-L   op_io();
+L   op_wait();
   }
   op_io();
 }
@@ -32,6 +32,7 @@ void CPUcore::core_serialize(serializer &s) {
   s.integer(dp);
 
   update_table();
+  idle_reset();
 }
 
 #endif
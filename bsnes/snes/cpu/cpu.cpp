@@ -5,11 +5,11 @@ namespace SNES {
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.cpp"
-  CPUDebugger cpu;
+  threadlocal CPUDebugger cpu;
   #include "debugger/analyst.cpp"
-  CPUAnalyst cpuAnalyst(cpu, cpu.usage);
+  threadlocal CPUAnalyst cpuAnalyst(cpu, cpu.usage);
 #else
-  CPU cpu;
+  threadlocal CPU cpu;
 #endif
 
 #include "serialization.cpp"
@@ -83,6 +83,7 @@ void CPU::enter() {
 }
 
 void CPU::op_step() {
+  if(idle.enabled) idle_step();
   (this->*opcode_table[op_readpc()])();
 }
 
@@ -132,6 +133,7 @@ void CPU::reset() {
   regs.wai  = false;
   regs.stp  = false;
   update_table();
+  idle_reset();
 
   mmio_reset();
   dma_reset();
@@ -130,10 +130,10 @@ private:
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.hpp"
-  extern CPUDebugger cpu;
+  extern threadlocal CPUDebugger cpu;
 
   #include "debugger/analyst.hpp"
-  extern CPUAnalyst cpuAnalyst;
+  extern threadlocal CPUAnalyst cpuAnalyst;
 #else
-  extern CPU cpu;
+  extern threadlocal CPU cpu;
 #endif
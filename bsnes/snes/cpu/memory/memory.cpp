@@ -7,6 +7,17 @@ void CPU::op_io() {
   alu_edge();
 }
 
+//WAI: consecutive I/O cycles inside an idle window differ only in the clock count
+void CPU::op_wait() {
+  unsigned count = idle.enabled && regs.wai ? idle_window() / 6 : 0;
+  if(count > 1) {
+    status.clock_count = 6;
+    add_clocks(count * 6);
+  } else {
+    op_io();
+  }
+}
+
 uint8 CPU::op_read(uint32 addr) {
   status.clock_count = speed(addr);
   dma_edge();
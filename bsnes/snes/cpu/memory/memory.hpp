@@ -1,4 +1,5 @@
 void op_io();
+void op_wait();
 debugvirtual uint8 op_read(uint32 addr);
 debugvirtual void op_write(uint32 addr, uint8 data);
 alwaysinline unsigned speed(unsigned addr) const;
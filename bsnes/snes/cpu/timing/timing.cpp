@@ -11,10 +11,84 @@ unsigned CPU::joypad_counter() {
   return counter.cpu & 255;
 }
 
+//returns how many of the next (ticks) 2-clock steps can be taken at once,
+//because none of them would alter NMI, IRQ, auto joypad or light gun state.
+//the step crossing a scanline boundary and those shortly after it are never
+//skipped, as the (h/v)counter_past() tests differ from the current position there.
+unsigned CPU::idle_ticks(unsigned ticks) {
+  if(hcounter() < 12) return 0;
+  if(input.tick_active()) return 0;
+
+  //poll_nmi() is a no-op once the hold has expired and nmi_valid is settled
+  if(status.nmi_hold) return 0;
+  if(status.nmi_valid != (vcounter() >= (!ppu.overscan() ? 225 : 240))) return 0;
+
+  //poll_irq() is a no-op once the hold has expired, any transition is latched
+  //and irq_valid already matches the V-IRQ test for this scanline
+  bool irq_enabled = status.virq_enabled || status.hirq_enabled;
+  if(status.irq_hold) return 0;
+  if(irq_enabled && status.irq_line && !status.irq_transition) return 0;
+  bool irq_valid = irq_enabled && !status.hirq_enabled && vcounter() == status.virq_pos;
+  if(status.irq_valid != irq_valid) return 0;
+
+  //stop before the step that reaches the end of the scanline
+  unsigned limit = ((lineclocks() - hcounter()) >> 1) - 1;
+
+  //stop before the H-IRQ position test would match
+  if(status.hirq_enabled) {
+    unsigned position = (status.hirq_pos + 1) * 4 + 10;
+    if(hcounter() < position) limit = min(limit, ((position - hcounter()) >> 1) - 1);
+  }
+
+  //stop before the next auto joypad edge during Vblank
+  if(vcounter() >= (!ppu.overscan() ? 225 : 240)) {
+    limit = min(limit, ((256 - joypad_counter()) >> 1) - 1);
+  }
+
+  return min(limit, ticks);
+}
+
+//returns how many clocks can pass before the S-CPU could observe any change:
+//no interrupt, auto joypad, DMA, HDMA or DRAM refresh activity and no scanline edge.
+//within this window, add_clocks() is equivalent to any sequence of smaller steps.
+unsigned CPU::idle_window() {
+  if(status.irq_lock || status.interrupt_pending || regs.irq) return 0;
+  if(status.dma_active || status.dma_pending || status.hdma_pending) return 0;
+  if(alu.mpyctr || alu.divctr) return 0;
+
+  unsigned clocks = idle_ticks(lineclocks()) << 1;
+  if(clocks == 0) return 0;
+
+  //stop before the DRAM refresh and HDMA tests in add_clocks() would match
+  unsigned edge = lineclocks();
+  if(!status.dram_refresh) edge = min(edge, status.dram_refresh_position);
+  if(!status.hdma_init_triggered) edge = min(edge, status.hdma_init_position);
+  if(!status.hdma_triggered) edge = min(edge, status.hdma_position);
+  if(hcounter() >= edge) return 0;
+  return min(clocks, edge - hcounter() - 1);
+}
+
+void CPU::idle_position(unsigned &vcounter, unsigned &hcounter) {
+  vcounter = this->vcounter();
+  hcounter = this->hcounter();
+}
+
+void CPU::idle_clocks(unsigned clocks) {
+  add_clocks(clocks);
+}
+
 void CPU::add_clocks(unsigned clocks) {
   status.irq_lock = false;
   unsigned ticks = clocks >> 1;
-  while(ticks--) {
+  while(ticks) {
+    if(unsigned idle = idle_ticks(ticks)) {
+      counter.cpu += idle << 1;
+      tick(idle << 1);
+      ticks -= idle;
+      continue;
+    }
+
+    ticks--;
     counter.cpu += 2;
     tick();
     if(hcounter() & 2) {
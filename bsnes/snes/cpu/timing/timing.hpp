@@ -2,6 +2,10 @@
 unsigned dma_counter();
 unsigned joypad_counter();
 
+alwaysinline unsigned idle_ticks(unsigned ticks);
+unsigned idle_window();
+void idle_position(unsigned &vcounter, unsigned &hcounter);
+void idle_clocks(unsigned clocks);
 void add_clocks(unsigned clocks);
 void scanline();
 
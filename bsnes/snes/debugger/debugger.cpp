@@ -1,6 +1,6 @@
 #ifdef SYSTEM_CPP
 
-Debugger debugger;
+threadlocal Debugger debugger;
 
 bool Debugger::Breakpoint::operator==(const uint8& data) const {
   if (this->data < 0) return true;
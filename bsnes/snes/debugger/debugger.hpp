@@ -81,4 +81,4 @@ public:
   Debugger();
 };
 
-extern Debugger debugger;
+extern threadlocal Debugger debugger;
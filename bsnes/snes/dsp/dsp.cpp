@@ -5,9 +5,9 @@ namespace SNES {
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.cpp"
-  DSPDebugger dsp;
+  threadlocal DSPDebugger dsp;
 #else
-  DSP dsp;
+  threadlocal DSP dsp;
 #endif
 
 #include "serialization.cpp"
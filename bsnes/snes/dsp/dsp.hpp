@@ -190,7 +190,7 @@ private:
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.hpp"
-  extern DSPDebugger dsp;
+  extern threadlocal DSPDebugger dsp;
 #else
-  extern DSP dsp;
+  extern threadlocal DSP dsp;
 #endif
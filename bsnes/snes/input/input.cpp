@@ -1,6 +1,6 @@
 #ifdef SYSTEM_CPP
 
-Input input;
+threadlocal Input input;
 
 uint8 Input::port_read(bool portnumber) {
   if(cartridge.has_serial() && portnumber == 1) {
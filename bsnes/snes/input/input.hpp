@@ -58,6 +58,9 @@ public:
     }
   }
 
+  //when false, tick() never has any effect and the CPU may skip calling it
+  alwaysinline bool tick_active() const { return iobit; }
+
 private:
   bool iobit;
   int16_t latchx, latchy;
@@ -103,4 +106,4 @@ private:
   friend class CPU;
 };
 
-extern Input input;
+extern threadlocal Input input;
@@ -3,6 +3,10 @@ public:
   virtual void video_extras(uint16_t *data, unsigned width, unsigned height) {}
   virtual void video_refresh(const uint16_t *data, unsigned width, unsigned height) {}
   virtual void audio_sample(uint16_t l_sample, uint16_t r_sample) {}
+  //interleaved stereo frames; called once per frame and whenever the core's output buffer fills
+  virtual void audio_sample_batch(const int16_t *data, unsigned frames) {
+    for(unsigned n = 0; n < frames; n++) audio_sample(data[n * 2 + 0], data[n * 2 + 1]);
+  }
   virtual void input_poll() {}
   virtual int16_t input_poll(bool port, Input::Device device, unsigned index, unsigned id) { return 0; }
 
@@ -7,6 +7,7 @@ using namespace nall;
 struct Interface : public SNES::Interface {
   snes_video_refresh_t pvideo_refresh;
   snes_audio_sample_t paudio_sample;
+  snes_audio_sample_batch_t paudio_sample_batch;
   snes_input_poll_t pinput_poll;
   snes_input_state_t pinput_state;
 
@@ -18,6 +19,11 @@ struct Interface : public SNES::Interface {
     if(paudio_sample) return paudio_sample(left, right);
   }
 
+  void audio_sample_batch(const int16_t *data, unsigned frames) {
+    if(paudio_sample_batch) return paudio_sample_batch(data, frames);
+    SNES::Interface::audio_sample_batch(data, frames);
+  }
+
   void input_poll() {
     if(pinput_poll) return pinput_poll();
   }
@@ -27,18 +33,18 @@ struct Interface : public SNES::Interface {
     return 0;
   }
 
-  Interface() : pvideo_refresh(0), paudio_sample(0), pinput_poll(0), pinput_state(0) {
+  Interface() : pvideo_refresh(0), paudio_sample(0), paudio_sample_batch(0), pinput_poll(0), pinput_state(0) {
   }
 };
 
-static Interface interface;
+static threadlocal Interface interface;
 
 unsigned snes_library_revision_major(void) {
   return 1;
 }
 
 unsigned snes_library_revision_minor(void) {
-  return 1;
+  return 4;
 }
 
 void snes_set_video_refresh(snes_video_refresh_t video_refresh) {
@@ -49,6 +55,10 @@ void snes_set_audio_sample(snes_audio_sample_t audio_sample) {
   interface.paudio_sample = audio_sample;
 }
 
+void snes_set_audio_sample_batch(snes_audio_sample_batch_t audio_sample_batch) {
+  interface.paudio_sample_batch = audio_sample_batch;
+}
+
 void snes_set_input_poll(snes_input_poll_t input_poll) {
   interface.pinput_poll = input_poll;
 }
@@ -65,6 +75,18 @@ void snes_set_cartridge_basename(const char *basename) {
   SNES::cartridge.basename = basename;
 }
 
+void snes_set_video_format(unsigned format, void *buffer, unsigned pitch) {
+  SNES::video.set_format((SNES::Video::Format)format, buffer, pitch);
+}
+
+void snes_set_video_normalize(bool normalize) {
+  SNES::video.set_normalize(normalize);
+}
+
+unsigned snes_get_video_line_width(unsigned line) {
+  return SNES::video.width(line);
+}
+
 void snes_init(void) {
   SNES::system.init(&interface);
   SNES::input.port_set_device(0, SNES::Input::Device::Joypad);
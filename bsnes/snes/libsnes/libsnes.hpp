@@ -51,6 +51,10 @@ extern "C" {
 #define SNES_REGION_NTSC  0
 #define SNES_REGION_PAL   1
 
+#define SNES_VIDEO_FORMAT_RGB555    0
+#define SNES_VIDEO_FORMAT_RGB565    1
+#define SNES_VIDEO_FORMAT_XRGB8888  2
+
 #define SNES_MEMORY_CARTRIDGE_RAM       0
 #define SNES_MEMORY_CARTRIDGE_RTC       1
 #define SNES_MEMORY_BSX_RAM             2
@@ -62,6 +66,7 @@ extern "C" {
 
 typedef void (*snes_video_refresh_t)(const uint16_t *data, unsigned width, unsigned height);
 typedef void (*snes_audio_sample_t)(uint16_t left, uint16_t right);
+typedef void (*snes_audio_sample_batch_t)(const int16_t *data, unsigned frames);
 typedef void (*snes_input_poll_t)(void);
 typedef int16_t (*snes_input_state_t)(bool port, unsigned device, unsigned index, unsigned id);
 
@@ -70,12 +75,32 @@ unsigned snes_library_revision_minor(void);
 
 void snes_set_video_refresh(snes_video_refresh_t);
 void snes_set_audio_sample(snes_audio_sample_t);
+//when set, replaces the audio_sample callback: receives interleaved left/right frames,
+//at least once per emulated frame (revision 1.2+)
+void snes_set_audio_sample_batch(snes_audio_sample_batch_t);
 void snes_set_input_poll(snes_input_poll_t);
 void snes_set_input_state(snes_input_state_t);
 
 void snes_set_controller_port_device(bool port, unsigned device);
 void snes_set_cartridge_basename(const char *basename);
 
+//RGB555 (the default) frames are internal to the library; other formats are written straight into
+//buffer (pitch in bytes), which video_refresh then receives as its data pointer. line y of field f
+//is row y * 2 + f, so progressive frames use a pitch of pitch * 2. the buffer must hold 478 rows
+//of 512 pixels (revision 1.3+)
+void snes_set_video_format(unsigned format, void *buffer, unsigned pitch);
+
+//frames mixing 256 and 512 pixel lines are widened to 512 pixels per line unless disabled here.
+//otherwise lowres lines of such frames hold 256 pixels, and snes_get_video_line_width() returns
+//the width of each line of the last frame (row / 2 for interlaced frames) (revision 1.4+)
+void snes_set_video_normalize(bool normalize);
+unsigned snes_get_video_line_width(unsigned line);
+
+//when built with MULTI=1, all state is thread_local: each host thread that calls
+//snes_init() drives its own independent console, and callbacks are per-thread.
+//there are no handle-taking entry points: every component reaches its siblings
+//through the SNES:: globals, so the calling thread itself is the instance handle.
+//every call for one console must come from the thread that called snes_init()
 void snes_init(void);
 void snes_term(void);
 void snes_power(void);
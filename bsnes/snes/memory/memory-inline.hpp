@@ -1,6 +1,8 @@
 //Memory
 
 unsigned Memory::size() const { return 0; }
+uint8* Memory::read_base() { return 0; }
+uint8* Memory::write_base() { return 0; }
 
 bool Memory::debugger_access() {
 #if defined(DEBUGGER)
@@ -19,6 +21,8 @@ uint8 StaticRAM::read(unsigned addr) { return data_[addr]; }
 void StaticRAM::write(unsigned addr, uint8 n) { data_[addr] = n; }
 uint8& StaticRAM::operator[](unsigned addr) { return data_[addr]; }
 const uint8& StaticRAM::operator[](unsigned addr) const { return data_[addr]; }
+uint8* StaticRAM::read_base() { return data_; }
+uint8* StaticRAM::write_base() { return data_; }
 
 StaticRAM::StaticRAM(unsigned n) : size_(n) { data_ = new uint8[size_]; }
 StaticRAM::~StaticRAM() { delete[] data_; }
@@ -55,6 +59,8 @@ unsigned MappedRAM::size() const { return size_; }
 uint8 MappedRAM::read(unsigned addr) { return data_[addr]; }
 void MappedRAM::write(unsigned addr, uint8 n) { if(!write_protect_ || debugger_access()) data_[addr] = n; }
 const uint8& MappedRAM::operator[](unsigned addr) const { return data_[addr]; }
+//writes stay virtual, as write protection can be toggled after mapping (eg BS-X flash)
+uint8* MappedRAM::read_base() { return data_; }
 MappedRAM::MappedRAM() : data_(0), size_(0), write_protect_(false) {}
 
 //VRAM
@@ -100,19 +106,15 @@ VRAM::VRAM() : MappedRAM() { reset(); }
 //Bus
 
 uint8 Bus::read(uint24 addr) {
-  #if defined(CHEAT_SYSTEM)
-  if(cheat.active() && cheat.exists(addr)) {
-    uint8 r;
-    if(cheat.read(addr, r, *this)) return r;
-  }
-  #endif
   Page &p = page[addr >> 8];
+  if(p.read_base) return p.read_base[addr & 0xff];
   return p.access->read(p.offset + addr);
 }
 
 void Bus::write(uint24 addr, uint8 data) {
   Page &p = page[addr >> 8];
-  p.access->write(p.offset + addr, data);
+  if(p.write_base) p.write_base[addr & 0xff] = data;
+  else p.access->write(p.offset + addr, data);
 }
 
 bool Bus::is_mirror(uint24 addr1, uint24 addr2) {
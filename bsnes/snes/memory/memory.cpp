@@ -3,20 +3,20 @@
 #define MEMORY_CPP
 namespace SNES {
 
-Bus bus;
+threadlocal Bus bus;
 
 #include "serialization.cpp"
 
 namespace memory {
-  MMIOAccess mmio;
-  StaticRAM wram(128 * 1024);
-  StaticRAM apuram(64 * 1024);
-  VRAM vram;
-  StaticRAM oam(544);
-  StaticRAM cgram(512);
-
-  UnmappedMemory memory_unmapped;
-  UnmappedMMIO mmio_unmapped;
+  threadlocal MMIOAccess mmio;
+  threadlocal StaticRAM wram(128 * 1024);
+  threadlocal StaticRAM apuram(64 * 1024);
+  threadlocal VRAM vram;
+  threadlocal StaticRAM oam(544);
+  threadlocal StaticRAM cgram(512);
+
+  threadlocal UnmappedMemory memory_unmapped;
+  threadlocal UnmappedMMIO mmio_unmapped;
 };
 
 unsigned UnmappedMemory::size() const { return 16 * 1024 * 1024; }
@@ -80,6 +80,19 @@ void Bus::map(unsigned addr, Memory &access, unsigned offset) {
   Page &p = page[addr >> 8];
   p.access = &access;
   p.offset = offset - addr;
+
+  //only whole pages inside the backing array can be accessed directly
+  bool direct = (offset & 0xff) == 0 && offset + 256 <= access.size();
+  p.read_base = direct && access.read_base() ? access.read_base() + offset : 0;
+  p.write_base = direct && access.write_base() ? access.write_base() + offset : 0;
+
+  #if defined(CHEAT_SYSTEM)
+  //pages holding active cheat codes are redirected to their overlay
+  if(Memory *overlay = cheat.overlay(access, offset)) {
+    p.access = overlay;
+    p.read_base = p.write_base = 0;
+  }
+  #endif
 }
 
 void Bus::map(
@@ -3,6 +3,11 @@ struct Memory {
   virtual uint8 read(unsigned addr) = 0;
   virtual void write(unsigned addr, uint8 data) = 0;
   static alwaysinline bool debugger_access();
+
+  //backing array, when read() / write() are plain array accesses without side effects;
+  //lets Bus pages bypass the virtual call. 0 = must go through read() / write()
+  virtual inline uint8* read_base();
+  virtual inline uint8* write_base();
 };
 
 struct MMIO {
@@ -29,6 +34,8 @@ struct StaticRAM : Memory {
   inline void write(unsigned addr, uint8 n);
   inline uint8& operator[](unsigned addr);
   inline const uint8& operator[](unsigned addr) const;
+  inline uint8* read_base();
+  inline uint8* write_base();
 
   inline StaticRAM(unsigned size);
   inline ~StaticRAM();
@@ -50,6 +57,7 @@ struct MappedRAM : Memory {
   inline uint8 read(unsigned addr);
   inline void write(unsigned addr, uint8 n);
   inline const uint8& operator[](unsigned addr) const;
+  inline uint8* read_base();
   inline MappedRAM();
 
 private:
@@ -110,12 +118,15 @@ struct Bus {
   struct Page {
     Memory *access;
     unsigned offset;
+    uint8 *read_base;   //when set, page data is read_base[addr & 0xff]
+    uint8 *write_base;  //when set, page data is write_base[addr & 0xff]
   } page[65536];
 
   void serialize(serializer&);
 
 private:
-  inline void map(unsigned addr, Memory &access, unsigned offset);
+  void map(unsigned addr, Memory &access, unsigned offset);
+  friend class Cheat;
 
   void map_reset();
   void map_xml();
@@ -123,15 +134,15 @@ private:
 };
 
 namespace memory {
-  extern MMIOAccess mmio;   //S-CPU, S-PPU
-  extern StaticRAM wram;    //S-CPU
-  extern StaticRAM apuram;  //S-SMP, S-DSP
-  extern VRAM vram;         //S-PPU
-  extern StaticRAM oam;     //S-PPU
-  extern StaticRAM cgram;   //S-PPU
-
-  extern UnmappedMemory memory_unmapped;
-  extern UnmappedMMIO mmio_unmapped;
+  extern threadlocal MMIOAccess mmio;   //S-CPU, S-PPU
+  extern threadlocal StaticRAM wram;    //S-CPU
+  extern threadlocal StaticRAM apuram;  //S-SMP, S-DSP
+  extern threadlocal VRAM vram;         //S-PPU
+  extern threadlocal StaticRAM oam;     //S-PPU
+  extern threadlocal StaticRAM cgram;   //S-PPU
+
+  extern threadlocal UnmappedMemory memory_unmapped;
+  extern threadlocal UnmappedMMIO mmio_unmapped;
 };
 
-extern Bus bus;
+extern threadlocal Bus bus;
@@ -178,6 +178,26 @@ void PPU::Background::run(bool screen) {
   }
 }
 
+void PPU::Background::run_line() {
+  //a layer that cannot output anything (inactive, disabled or windowed out on both screens)
+  //leaves every pixel at priority 0 (transparent); its fetch state is reinitialized by
+  //scanline() before it could be observed again
+  const PPU::Window::Line &window = self.window.line[id];
+  bool main = regs.main_enable && !window.main.full();
+  bool sub = regs.sub_enable && !window.sub.full();
+  if(regs.mode == Mode::Inactive || (!main && !sub)) {
+    for(unsigned x = 0; x < 256; x++) line[x].main.priority = line[x].sub.priority = 0;
+    return;
+  }
+  if(regs.mode == Mode::Mode7 && self.vcounter() != 0) return run_line_mode7();
+
+  for(signed pixel = -7; pixel <= 255; pixel++) {
+    run(Screen::Sub);
+    run(Screen::Main);
+    if(pixel >= 0) line[pixel] = output;
+  }
+}
+
 unsigned PPU::Background::get_tile_color() {
   unsigned color = 0;
   switch(regs.mode) {
@@ -34,6 +34,7 @@ class Background {
   struct Output {
     Pixel main, sub;
   } output;
+  Output line[256];  //output of each pixel, for PPU::render_line()
 
   struct {
     signed x;
@@ -54,6 +55,7 @@ class Background {
   void frame();
   void scanline();
   void run(bool screen);
+  void run_line();
   void reset();
 
   void get_tile();
@@ -61,6 +63,7 @@ class Background {
   unsigned get_tile(unsigned x, unsigned y);
   signed clip(signed n);
   void run_mode7();
+  void run_line_mode7();
 
   void serialize(serializer&);
   Background(PPU &self, unsigned id);
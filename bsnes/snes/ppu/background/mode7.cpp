@@ -102,4 +102,101 @@ void PPU::Background::run_mode7() {
   }
 }
 
+//equivalent to run(Sub), run(Main) for pixels -7 through 255: mode 7 is never hires, so
+//run(Sub) only clears the output, and the affine transform of the whole line is computed
+//in branch-free passes that the compiler vectorizes
+void PPU::Background::run_line_mode7() {
+  //the tile fetches are not used by mode 7; only the state left by the last one is kept
+  signed fetch = -8;
+  for(signed pixel = -7; pixel <= 255; pixel++) {
+    if(tile_counter-- == 0) {
+      tile_counter = 7;
+      fetch = pixel;
+    }
+  }
+  if(fetch >= -7) {
+    x = fetch;
+    get_tile();
+  }
+  x = 256;
+
+  signed a = sclip<16>(self.regs.m7a);
+  signed b = sclip<16>(self.regs.m7b);
+  signed c = sclip<16>(self.regs.m7c);
+  signed d = sclip<16>(self.regs.m7d);
+
+  signed cx = sclip<13>(self.regs.m7x);
+  signed cy = sclip<13>(self.regs.m7y);
+  signed hoffset = sclip<13>(self.regs.mode7_hoffset);
+  signed voffset = sclip<13>(self.regs.mode7_voffset);
+
+  unsigned y = Background::y;
+  if(self.bg1.regs.mosaic) y -= self.mosaic_vcounter(); //BG2 vertical mosaic uses BG1 mosaic size
+  if(self.regs.mode7_vflip) y = 255 - y;
+
+  int16 mosaic_x[256];
+  for(unsigned pixel = 0; pixel < 256; pixel++) {
+    unsigned x = mosaic_hoffset;
+    if(--mosaic_hcounter == 0) {
+      mosaic_hcounter = self.regs.mosaic_size;
+      mosaic_hoffset += self.regs.mosaic_size;
+    }
+    mosaic_x[pixel] = self.regs.mode7_hflip ? 255 - x : x;
+  }
+
+  signed psx = ((a * clip(hoffset - cx)) & ~63) + ((b * clip(voffset - cy)) & ~63) + ((b * y) & ~63) + (cx << 8);
+  signed psy = ((c * clip(hoffset - cx)) & ~63) + ((d * clip(voffset - cy)) & ~63) + ((d * y) & ~63) + (cy << 8);
+
+  const uint8 *vram = &memory::vram[0];
+  const int16 a16 = a, c16 = c;
+  uint16 addr[256];
+  uint8 tile[256], fine[256], inside[256], pixel[256];
+  for(unsigned x = 0; x < 256; x++) {
+    //mask pseudo-FP bits
+    signed px = (psx + a16 * mosaic_x[x]) >> 8;
+    signed py = (psy + c16 * mosaic_x[x]) >> 8;
+    addr[x] = ((((py >> 3) & 127) << 7) + ((px >> 3) & 127)) << 1;
+    fine[x] = ((py & 7) << 3) + (px & 7);
+    inside[x] = ((px | py) & ~1023) ? 0x00 : 0xff;
+  }
+  for(unsigned x = 0; x < 256; x++) tile[x] = vram[addr[x]];
+  //character 0 repetition outside of screen area
+  if(self.regs.mode7_repeat == 3) {
+    for(unsigned x = 0; x < 256; x++) tile[x] &= inside[x];
+  }
+  for(unsigned x = 0; x < 256; x++) addr[x] = (((tile[x] << 6) + fine[x]) << 1) + 1;
+  for(unsigned x = 0; x < 256; x++) pixel[x] = vram[addr[x]];
+  //palette color 0 outside of screen area
+  if(self.regs.mode7_repeat == 2) {
+    for(unsigned x = 0; x < 256; x++) pixel[x] &= inside[x];
+  }
+
+  for(unsigned x = 0; x < 256; x++) {
+    output.main.priority = 0;
+    output.sub.priority = 0;
+
+    unsigned palette = pixel[x];
+    unsigned priority = regs.priority0;
+    if(id == ID::BG2) {
+      priority = (palette & 0x80 ? regs.priority1 : regs.priority0);
+      palette &= 0x7f;
+    }
+
+    if(palette) {
+      if(regs.main_enable) {
+        output.main.palette = palette;
+        output.main.priority = priority;
+        output.main.tile = 0;
+      }
+
+      if(regs.sub_enable) {
+        output.sub.palette = palette;
+        output.sub.priority = priority;
+        output.sub.tile = 0;
+      }
+    }
+    line[x] = output;
+  }
+}
+
 #endif
@@ -5,9 +5,9 @@ namespace SNES {
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.cpp"
-  PPUDebugger ppu;
+  threadlocal PPUDebugger ppu;
 #else
-  PPU ppu;
+  threadlocal PPU ppu;
 #endif
 
 #include "background/background.cpp"
@@ -47,7 +47,10 @@ void PPU::enter() {
     add_clocks(28);
 
     if(vcounter() <= (!regs.overscan ? 224 : 239)) {
-      for(signed pixel = -7; pixel <= 255; pixel++) {
+      //the S-CPU synchronizes with the PPU before every MMIO access; so when the PPU trails
+      //it by the whole line, no register can change mid-line and the line is batched
+      if(clock + 263 * 4 <= 0) render_line();
+      else for(signed pixel = -7; pixel <= 255; pixel++) {
         bg1.run(1);
         bg2.run(1);
         bg3.run(1);
@@ -66,6 +69,8 @@ void PPU::enter() {
         add_clocks(2);
       }
 
+      if(vcounter() != 0) video.line(screen.output - 512, 512);
+
       add_clocks(14 + 34*2);
       oam.tilefetch();
     }
@@ -74,6 +79,29 @@ void PPU::enter() {
   }
 }
 
+//equivalent to the per-dot loop in enter() while no register changes: each background
+//only depends on its own state, so it is run across the line before the pixels are composed
+void PPU::render_line() {
+  window.run_line();
+  bg1.run_line();
+  bg2.run_line();
+  bg3.run_line();
+  bg4.run_line();
+
+  for(unsigned x = 0; x < 256; x++) {
+    bg1.output = bg1.line[x];
+    bg2.output = bg2.line[x];
+    bg3.output = bg3.line[x];
+    bg4.output = bg4.line[x];
+    oam.run();
+    window.apply(x);
+    if(vcounter() != 0) screen.compose();
+  }
+  if(vcounter() != 0) screen.apply_brightness();
+
+  add_clocks(263 * 4);
+}
+
 void PPU::add_clocks(unsigned clocks) {
   clocks >>= 1;
   while(clocks--) {
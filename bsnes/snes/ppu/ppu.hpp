@@ -57,6 +57,7 @@ private:
 
   static void Enter();
   void add_clocks(unsigned);
+  void render_line();
 
   void scanline();
   void frame();
@@ -72,7 +73,7 @@ private:
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.hpp"
-  extern PPUDebugger ppu;
+  extern threadlocal PPUDebugger ppu;
 #else
-  extern PPU ppu;
+  extern threadlocal PPU ppu;
 #endif
@@ -0,0 +1,16 @@
+//master brightness ($2100) for one output line; shared by both PPU renderers.
+//equivalent to the former light_table[brightness][] lookup: each channel is scaled by
+//brightness / 15 with rounding (x / 30 == x * 2185 >> 16 for x < 1024), and red and blue
+//are exchanged into output order; written per channel so that the compiler can vectorize it
+
+inline void scale_brightness(uint16 *data, unsigned width, unsigned brightness) {
+  const uint16 scale = brightness * 2;
+  for(unsigned n = 0; n < width; n++) {
+    uint16 color = data[n];
+    uint16 r = (color >> 0) & 31, g = (color >> 5) & 31, b = (color >> 10) & 31;
+    //16-bit intermediates, so that the division becomes a high-half multiply
+    r = r * scale + 15, g = g * scale + 15, b = b * scale + 15;
+    r = (uint32)r * 2185 >> 16, g = (uint32)g * 2185 >> 16, b = (uint32)b * 2185 >> 16;
+    data[n] = (r << 10) + (g << 5) + b;
+  }
+}
@@ -15,14 +15,26 @@ void PPU::Screen::scanline() {
   math.color_halve = regs.color_halve && !regs.addsub_mode && math.main.color_enable;
 }
 
-void PPU::Screen::run() {
-  if(ppu.vcounter() == 0) return;
-
+//writes both output pixels of the current dot, before brightness is applied
+alwaysinline void PPU::Screen::compose() {
   bool hires = self.regs.pseudo_hires || self.regs.bgmode == 5 || self.regs.bgmode == 6;
   uint16 sscolor = get_pixel_sub(hires);
   uint16 mscolor = get_pixel_main();
-  *output++ = light_table[self.regs.display_brightness][hires ? sscolor : mscolor];
-  *output++ = light_table[self.regs.display_brightness][mscolor];
+  *output++ = hires ? sscolor : mscolor;
+  *output++ = mscolor;
+}
+
+void PPU::Screen::run() {
+  if(ppu.vcounter() == 0) return;
+
+  compose();
+  output[-2] = light_table[self.regs.display_brightness][output[-2]];
+  output[-1] = light_table[self.regs.display_brightness][output[-1]];
+}
+
+//applied to the last composed line
+void PPU::Screen::apply_brightness() {
+  scale_brightness(output - 512, 512, self.regs.display_brightness);
 }
 
 uint16 PPU::Screen::get_pixel_sub(bool hires) {
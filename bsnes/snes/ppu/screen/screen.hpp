@@ -29,6 +29,8 @@ class Screen {
 
   void scanline();
   void run();
+  void compose();
+  void apply_brightness();
   void reset();
 
   uint16 light_table[16][32768];
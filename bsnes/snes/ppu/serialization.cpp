@@ -136,6 +136,7 @@ void PPU::Sprite::serialize(serializer &s) {
     s.integer(list[i].priority);
     s.integer(list[i].palette);
     s.integer(list[i].size);
+    if(s.mode() == serializer::Load) update_packed(i);
   }
 
   s.integer(t.x);
@@ -8,8 +8,10 @@ void PPU::Sprite::update(unsigned addr, uint8 data) {
     addr &= 3;
     if(addr == 0) {
       list[n].x = (list[n].x & 0x100) | data;
+      packed.x[n] = list[n].x;
     } else if(addr == 1) {
       list[n].y = data;
+      packed.y[n] = data;
     } else if(addr == 2) {
       list[n].character = data;
     } else {  //(addr == 3)
@@ -29,28 +31,43 @@ void PPU::Sprite::update(unsigned addr, uint8 data) {
     list[n + 2].size = data & 0x20;
     list[n + 3].x = ((data & 0x40) << 2) | (list[n + 3].x & 0xff);
     list[n + 3].size = data & 0x80;
+    for(unsigned i = 0; i < 4; i++) update_packed(n + i);
   }
 }
 
-unsigned PPU::Sprite::SpriteItem::width() const {
+void PPU::Sprite::update_packed(unsigned n) {
+  packed.x[n] = list[n].x;
+  packed.y[n] = list[n].y;
+  packed.size[n] = list[n].size;
+}
+
+unsigned PPU::Sprite::width(bool size) const {
   if(size == 0) {
     static unsigned width[] = {  8,  8,  8, 16, 16, 32, 16, 16 };
-    return width[ppu.oam.regs.base_size];
+    return width[regs.base_size];
   } else {
     static unsigned width[] = { 16, 32, 64, 32, 64, 64, 32, 32 };
-    return width[ppu.oam.regs.base_size];
+    return width[regs.base_size];
   }
 }
 
-unsigned PPU::Sprite::SpriteItem::height() const {
+unsigned PPU::Sprite::height(bool size) const {
   if(size == 0) {
-    if(ppu.oam.regs.interlace && ppu.oam.regs.base_size >= 6) return 16;
+    if(regs.interlace && regs.base_size >= 6) return 16;
     static unsigned height[] = {  8,  8,  8, 16, 16, 32, 32, 32 };
-    return height[ppu.oam.regs.base_size];
+    return height[regs.base_size];
   } else {
     static unsigned height[] = { 16, 32, 64, 32, 64, 64, 64, 32 };
-    return height[ppu.oam.regs.base_size];
+    return height[regs.base_size];
   }
 }
 
+unsigned PPU::Sprite::SpriteItem::width() const {
+  return ppu.oam.width(size);
+}
+
+unsigned PPU::Sprite::SpriteItem::height() const {
+  return ppu.oam.height(size);
+}
+
 #endif
@@ -33,11 +33,46 @@ void PPU::Sprite::scanline() {
   memset(oam_item, 0xff, 32);  //default to invalid
   for(unsigned i = 0; i < 34; i++) oam_tile[i].x = 0xffff;  //default to invalid
 
-  for(unsigned i = 0; i < 128; i++) {
-    unsigned sprite = (regs.first_sprite + i) & 127;
-    if(on_scanline(list[sprite]) == false) continue;
-    if(t.item_count++ >= 32) break;
-    oam_item[t.item_count - 1] = sprite;
+  //range test all sprites at once (branch-free, so it vectorizes), then visit the ones on
+  //this line in priority order starting from first_sprite
+  const uint16 y = t.y;
+  const uint16 width0 = width(0), width1 = width(1);
+  const uint16 height0 = height(0) >> regs.interlace, height1 = height(1) >> regs.interlace;
+  uint8 in_range[128];
+  for(unsigned n = 0; n < 128; n++) {
+    uint16 x = packed.x[n], top = packed.y[n];
+    uint16 width = packed.size[n] ? width1 : width0;
+    uint16 bottom = top + (packed.size[n] ? height1 : height0);
+    //sprites entirely offscreen that do not wrap around to the left side are not counted.
+    //this *should* be 256, and not 255, even though dot 256 is offscreen.
+    bool offscreen = (x > 256) & ((uint16)(x + width - 1) < 512);
+    bool visible = ((y >= top) & (y < bottom)) | ((bottom >= 256) & (y < (bottom & 255)));
+    in_range[n] = visible & !offscreen;
+  }
+
+  uint64 mask[2] = { 0, 0 };
+  for(unsigned n = 0; n < 128; n++) mask[n >> 6] |= (uint64)in_range[n] << (n & 63);
+
+  //rotate so that bit 0 is first_sprite
+  unsigned first = regs.first_sprite;
+  if(first >= 64) {
+    uint64 lo = mask[0];
+    mask[0] = mask[1];
+    mask[1] = lo;
+    first -= 64;
+  }
+  if(first) {
+    uint64 lo = mask[0], hi = mask[1];
+    mask[0] = (lo >> first) | (hi << (64 - first));
+    mask[1] = (hi >> first) | (lo << (64 - first));
+  }
+
+  for(unsigned half = 0; half < 2; half++) {
+    for(uint64 bits = mask[half]; bits; bits = bit::clear_lowest(bits)) {
+      if(t.item_count++ >= 32) break;
+      oam_item[t.item_count - 1] = (regs.first_sprite + (half << 6) + bit::first(bits)) & 127;
+    }
+    if(t.item_count > 32) break;
   }
 
   if(t.item_count > 0 && oam_item[t.item_count - 1] != 0xff) {
@@ -45,14 +80,6 @@ void PPU::Sprite::scanline() {
   }
 }
 
-bool PPU::Sprite::on_scanline(SpriteItem &sprite) {
-  if(sprite.x > 256 && (sprite.x + sprite.width() - 1) < 512) return false;
-  signed height = (regs.interlace == false ? sprite.height() : (sprite.height() >> 1));
-  if(t.y >= sprite.y && t.y < (sprite.y + height)) return true;
-  if((sprite.y + height) >= 256 && t.y < ((sprite.y + height) & 255)) return true;
-  return false;
-}
-
 void PPU::Sprite::run() {
   output.main.priority = 0;
   output.sub.priority = 0;
@@ -168,6 +195,7 @@ void PPU::Sprite::reset() {
     list[i].priority = 0;
     list[i].palette = 0;
     list[i].size = 0;
+    update_packed(i);
   }
 
   t.x = 0;
@@ -13,6 +13,13 @@ class Sprite {
     unsigned height() const;
   } list[128];
 
+  //structure-of-arrays copy of the list fields read by the range test, kept in sync by update()
+  struct Packed {
+    uint16 x[128];
+    uint16 y[128];
+    uint16 size[128];
+  } packed;
+
   struct TileItem {
     uint16 x;
     uint16 priority;
@@ -61,6 +68,9 @@ class Sprite {
 
   //list.cpp
   void update(unsigned addr, uint8 data);
+  void update_packed(unsigned n);
+  unsigned width(bool size) const;
+  unsigned height(bool size) const;
 
   //sprite.cpp
   void address_reset();
@@ -71,8 +81,6 @@ class Sprite {
   void tilefetch();
   void reset();
 
-  bool on_scanline(SpriteItem&);
-
   void serialize(serializer&);
   Sprite(PPU &self);
 
@@ -0,0 +1,51 @@
+//window state for one scanline, one bit per pixel; shared by both PPU renderers.
+//the window ranges become spans of set bits, so the logic operators and inversions
+//are applied 64 pixels at a time instead of being evaluated for every pixel
+
+struct WindowMask {
+  uint64 bits[4];
+
+  alwaysinline bool operator[](unsigned x) const {
+    return (bits[x >> 6] >> (x & 63)) & 1;
+  }
+
+  //sets pixels left through right (inclusive) only; a window with left > right is empty
+  inline void range(unsigned left, unsigned right) {
+    for(unsigned n = 0; n < 4; n++) {
+      unsigned lo = max(left, n * 64), hi = min(right, n * 64 + 63);
+      bits[n] = lo > hi ? 0 : (~0ull >> (63 - (hi - lo))) << (lo - n * 64);
+    }
+  }
+
+  inline void fill(bool value) {
+    for(unsigned n = 0; n < 4; n++) bits[n] = value ? ~0ull : 0;
+  }
+
+  inline void invert() {
+    for(unsigned n = 0; n < 4; n++) bits[n] = ~bits[n];
+  }
+
+  inline bool empty() const { return (bits[0] | bits[1] | bits[2] | bits[3]) == 0; }
+  inline bool full() const { return (bits[0] & bits[1] & bits[2] & bits[3]) == ~0ull; }
+
+  //combines the two window ranges as selected by $2123-$2125 (enable, invert) and $212a-$212b (logic)
+  inline void combine(
+    const WindowMask &one, bool one_enable, bool one_invert,
+    const WindowMask &two, bool two_enable, bool two_invert,
+    unsigned logic
+  ) {
+    if(one_enable == false && two_enable == false) return fill(false);
+    for(unsigned n = 0; n < 4; n++) {
+      uint64 a = one.bits[n] ^ (one_invert ? ~0ull : 0);
+      uint64 b = two.bits[n] ^ (two_invert ? ~0ull : 0);
+      if(two_enable == false) bits[n] = a;
+      else if(one_enable == false) bits[n] = b;
+      else switch(logic & 3) {
+        case 0: bits[n] = a | b; break;
+        case 1: bits[n] = a & b; break;
+        case 2: bits[n] = a ^ b; break;
+        case 3: bits[n] = ~(a ^ b); break;
+      }
+    }
+  }
+};
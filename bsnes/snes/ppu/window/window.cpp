@@ -80,6 +80,89 @@ void PPU::Window::run() {
   output.sub.color_enable = sub;
 }
 
+//equivalent to run() for each pixel of a line during which no register changes
+void PPU::Window::run_line() {
+  WindowMask one, two;
+  one.range(regs.one_left, regs.one_right);
+  two.range(regs.two_left, regs.two_right);
+  x = 256;
+  Window::one = one[255];
+  Window::two = two[255];
+
+  test_line(
+    line[0], one, two,
+    regs.bg1_one_enable, regs.bg1_one_invert,
+    regs.bg1_two_enable, regs.bg1_two_invert,
+    regs.bg1_mask, regs.bg1_main_enable, regs.bg1_sub_enable
+  );
+
+  test_line(
+    line[1], one, two,
+    regs.bg2_one_enable, regs.bg2_one_invert,
+    regs.bg2_two_enable, regs.bg2_two_invert,
+    regs.bg2_mask, regs.bg2_main_enable, regs.bg2_sub_enable
+  );
+
+  test_line(
+    line[2], one, two,
+    regs.bg3_one_enable, regs.bg3_one_invert,
+    regs.bg3_two_enable, regs.bg3_two_invert,
+    regs.bg3_mask, regs.bg3_main_enable, regs.bg3_sub_enable
+  );
+
+  test_line(
+    line[3], one, two,
+    regs.bg4_one_enable, regs.bg4_one_invert,
+    regs.bg4_two_enable, regs.bg4_two_invert,
+    regs.bg4_mask, regs.bg4_main_enable, regs.bg4_sub_enable
+  );
+
+  test_line(
+    line[4], one, two,
+    regs.oam_one_enable, regs.oam_one_invert,
+    regs.oam_two_enable, regs.oam_two_invert,
+    regs.oam_mask, regs.oam_main_enable, regs.oam_sub_enable
+  );
+
+  test_line(
+    line[5], one, two,
+    regs.col_one_enable, regs.col_one_invert,
+    regs.col_two_enable, regs.col_two_invert,
+    regs.col_mask, true, true
+  );
+
+  switch(regs.col_main_mask) {
+    case 0: line[5].main.fill(true); break;
+    case 1: break;
+    case 2: line[5].main.invert(); break;
+    case 3: line[5].main.fill(false); break;
+  }
+
+  switch(regs.col_sub_mask) {
+    case 0: line[5].sub.fill(true); break;
+    case 1: break;
+    case 2: line[5].sub.invert(); break;
+    case 3: line[5].sub.fill(false); break;
+  }
+}
+
+//applies the masks built by run_line() to the layer outputs of pixel x
+alwaysinline void PPU::Window::apply(unsigned x) {
+  if(line[0].main[x]) self.bg1.output.main.priority = 0;
+  if(line[0].sub[x]) self.bg1.output.sub.priority = 0;
+  if(line[1].main[x]) self.bg2.output.main.priority = 0;
+  if(line[1].sub[x]) self.bg2.output.sub.priority = 0;
+  if(line[2].main[x]) self.bg3.output.main.priority = 0;
+  if(line[2].sub[x]) self.bg3.output.sub.priority = 0;
+  if(line[3].main[x]) self.bg4.output.main.priority = 0;
+  if(line[3].sub[x]) self.bg4.output.sub.priority = 0;
+  if(line[4].main[x]) self.oam.output.main.priority = 0;
+  if(line[4].sub[x]) self.oam.output.sub.priority = 0;
+
+  output.main.color_enable = line[5].main[x];
+  output.sub.color_enable = line[5].sub[x];
+}
+
 void PPU::Window::test(
   bool &main, bool &sub,
   bool one_enable, bool one_invert,
@@ -107,6 +190,21 @@ void PPU::Window::test(
   sub = sub_enable ? output : false;
 }
 
+void PPU::Window::test_line(
+  Line &line, const WindowMask &one, const WindowMask &two,
+  bool one_enable, bool one_invert,
+  bool two_enable, bool two_invert,
+  uint8 mask, bool main_enable, bool sub_enable
+) {
+  WindowMask output;
+  output.combine(one, one_enable, one_invert, two, two_enable, two_invert, mask);
+
+  if(main_enable) line.main = output;
+  else line.main.fill(false);
+  if(sub_enable) line.sub = output;
+  else line.sub.fill(false);
+}
+
 void PPU::Window::reset() {
   regs.bg1_one_enable = random(false);
   regs.bg1_one_invert = random(false);
@@ -69,8 +69,16 @@ class Window {
     bool two;
   };
 
+  //per-line form of run(), for PPU::render_line(): main and sub masks of each layer
+  //(BG1-4, OAM: set = pixel hidden; COL: set = color math enabled)
+  struct Line {
+    WindowMask main, sub;
+  } line[6];
+
   void scanline();
   void run();
+  void run_line();
+  void apply(unsigned x);
   void reset();
 
   void test(
@@ -79,6 +87,12 @@ class Window {
     bool two_enable, bool two_invert,
     uint8 mask, bool main_enable, bool sub_enable
   );
+  void test_line(
+    Line &line, const WindowMask &one, const WindowMask &two,
+    bool one_enable, bool one_invert,
+    bool two_enable, bool two_invert,
+    uint8 mask, bool main_enable, bool sub_enable
+  );
 
   void serialize(serializer&);
   Window(PPU &self);
@@ -1,9 +1,10 @@
 #ifdef SYSTEM_CPP
 
-Scheduler scheduler;
+threadlocal Scheduler scheduler;
 
 void Scheduler::enter() {
   host_thread = co_active();
+  unpark(thread);
   co_switch(thread);
 }
 
@@ -16,13 +17,36 @@ void Scheduler::exit(ExitReason reason) {
 void Scheduler::resume(cothread_t& thread) {
   if (mode == Mode::Synchronize)
     desynchronized = true;
+  unpark(thread);
   co_switch(thread);
 }
 
+bool Scheduler::parked(cothread_t thread) const {
+  for(unsigned i = 0; i < parked_count; i++) {
+    if(parked_thread[i] == thread) return true;
+  }
+  return false;
+}
+
+void Scheduler::park(cothread_t thread) {
+  if(parked(thread) || parked_count >= 16) return;
+  parked_thread[parked_count++] = thread;
+}
+
+void Scheduler::unpark(cothread_t thread) {
+  for(unsigned i = 0; i < parked_count; i++) {
+    if(parked_thread[i] == thread) {
+      parked_thread[i] = parked_thread[--parked_count];
+      return;
+    }
+  }
+}
+
 void Scheduler::init() {
   host_thread = co_active();
   thread = cpu.thread;
   desynchronized = false;
+  parked_count = 0;
   mode = Mode::Synchronize;
 }
 
@@ -30,6 +54,7 @@ Scheduler::Scheduler() {
   host_thread = 0;
   thread = 0;
   desynchronized = false;
+  parked_count = 0;
   exit_reason = ExitReason::UnknownEvent;
 }
 
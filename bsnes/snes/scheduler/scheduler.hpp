@@ -7,6 +7,12 @@ struct Scheduler : property<Scheduler> {
   cothread_t thread;       //active emulation thread (used to enter emulation)
   bool desynchronized;
 
+  //threads suspended at their synchronization point and not entered since;
+  //System::runtosave() does not need to run these again
+  cothread_t parked_thread[16];
+  unsigned parked_count;
+  bool parked(cothread_t) const;
+
   void enter();
   void exit(ExitReason);
   void resume(cothread_t& thread);
@@ -14,6 +20,8 @@ struct Scheduler : property<Scheduler> {
   inline bool synchronizing() const { return mode == Mode::Synchronize; }
   inline void synchronize() {
     if (mode == Mode::Synchronize) {
+      //either way, this thread now waits at its synchronization point
+      park(co_active());
       if (desynchronized) {
         desynchronized = false;
         exit(ExitReason::DesynchronizeEvent);
@@ -26,6 +34,10 @@ struct Scheduler : property<Scheduler> {
 
   void init();
   Scheduler();
+
+private:
+  void park(cothread_t);
+  void unpark(cothread_t);
 };
 
-extern Scheduler scheduler;
+extern threadlocal Scheduler scheduler;
@@ -5,9 +5,9 @@ namespace SNES {
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.cpp"
-  SMPDebugger smp;
+  threadlocal SMPDebugger smp;
 #else
-  SMP smp;
+  threadlocal SMP smp;
 #endif
 
 #include "serialization.cpp"
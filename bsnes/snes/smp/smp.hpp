@@ -62,7 +62,7 @@ private:
 
 #if defined(DEBUGGER)
   #include "debugger/debugger.hpp"
-  extern SMPDebugger smp;
+  extern threadlocal SMPDebugger smp;
 #else
-  extern SMP smp;
+  extern threadlocal SMP smp;
 #endif
@@ -43,6 +43,15 @@ using namespace nall;
   #define debugvirtual
 #endif
 
+//MULTI_INSTANCE gives every host thread its own console: all emulated components
+//are thread_local, so each thread that calls System::init() owns an independent SNES.
+//(requires LIBCO_MP; the Super Game Boy plugin itself remains process-global)
+#ifdef MULTI_INSTANCE
+  #define threadlocal thread_local
+#else
+  #define threadlocal
+#endif
+
 namespace SNES {
   typedef int8_t   int8;
   typedef int16_t  int16;
@@ -127,6 +136,8 @@ namespace SNES {
   #include <cpu/core/core.hpp>
   #include <smp/core/core.hpp>
   #include <ppu/counter/counter.hpp>
+  #include <ppu/window/mask.hpp>
+  #include <ppu/screen/brightness.hpp>
 
   #if defined(PROFILE_ACCURACY)
   #include "profile-accuracy.hpp"
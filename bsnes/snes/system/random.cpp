@@ -1,4 +1,4 @@
-Random random;
+threadlocal Random random;
 
 void Random::seed(unsigned seed) {
   _random.seed = seed;
@@ -2,28 +2,47 @@
 
 serializer System::serialize() {
   serializer s(serialize_size);
-
-  unsigned signature = Info::SerializerSignature, version = Info::SerializerVersion, crc32 = cartridge.crc32();
-  char profile[16], description[512];
-  memset(&profile, 0, sizeof profile);
-  memset(&description, 0, sizeof description);
-  strlcpy(profile, Info::Profile, sizeof profile);
-
-  s.integer(signature);
-  s.integer(version);
-  s.integer(crc32);
-  s.array(profile);
-  s.array(description);
-
+  serialize_header(s);
   serialize_all(s);
   return s;
 }
 
 bool System::unserialize(serializer &s) {
-  unsigned signature, version, crc32;
-  char profile[16], description[512];
+  if(s.capacity() != serialize_size) return false;
+  if(!serialize_header(s)) return false;
 
+  reset();
+  serialize_all(s);
+  return true;
+}
+
+void System::snapshot(serializer &s) {
+  if(s.capacity() != serialize_size) s = serializer(serialize_size);
+  s.restart(serializer::Save);
+  serialize_header(s);
+  serialize_all(s);
+}
+
+bool System::restore(serializer &s) {
   if(s.capacity() != serialize_size) return false;
+  s.restart(serializer::Load);
+  if(!serialize_header(s)) return false;
+
+  serialize_all(s);
+  return true;
+}
+
+//========
+//internal
+//========
+
+//writes the header, or reads it back and checks that the state is compatible
+bool System::serialize_header(serializer &s) {
+  unsigned signature = Info::SerializerSignature, version = Info::SerializerVersion, crc32 = cartridge.crc32();
+  char profile[16], description[512];
+  memset(&profile, 0, sizeof profile);
+  memset(&description, 0, sizeof description);
+  strlcpy(profile, Info::Profile, sizeof profile);
 
   s.integer(signature);
   s.integer(version);
@@ -35,16 +54,9 @@ bool System::unserialize(serializer &s) {
   if(version != Info::SerializerVersion) return false;
 //if(crc32 != cartridge.crc32()) return false;
   if(strcmp(profile, Info::Profile)) return false;
-
-  reset();
-  serialize_all(s);
   return true;
 }
 
-//========
-//internal
-//========
-
 void System::serialize(serializer &s) {
   s.integer((unsigned&)region);
   s.integer((unsigned&)expansion);
@@ -83,16 +95,7 @@ void System::serialize_all(serializer &s) {
 //as amount varies per game (eg different RAM sizes, special chips, etc.)
 void System::serialize_init() {
   serializer s;
-
-  unsigned signature = 0, version = 0, crc32 = 0;
-  char profile[16], description[512];
-
-  s.integer(signature);
-  s.integer(version);
-  s.integer(crc32);
-  s.array(profile);
-  s.array(description);
-
+  serialize_header(s);
   serialize_all(s);
   serialize_size = s.size();
 }
@@ -3,7 +3,7 @@
 #define SYSTEM_CPP
 namespace SNES {
 
-System system;
+threadlocal System system;
 
 #include <config/config.cpp>
 #include <debugger/debugger.cpp>
@@ -23,6 +23,7 @@ void System::run() {
   if(scheduler.exit_reason() == Scheduler::ExitReason::FrameEvent) {
     input.update();
     video.update();
+    audio.update();
   }
 }
 
@@ -57,6 +58,9 @@ void System::runtosave() {
 }
 
 bool System::runthreadtosave(cothread_t& thread) {
+  //already waiting at its synchronization point (eg from a previous runtosave())
+  if(scheduler.parked(thread)) return true;
+
   scheduler.thread = thread;
   while(true) {
     scheduler.enter();
@@ -65,6 +69,7 @@ bool System::runthreadtosave(cothread_t& thread) {
     if(scheduler.exit_reason() == Scheduler::ExitReason::FrameEvent) {
       input.update();
       video.update();
+      audio.update();
     }
   }
   return true;
@@ -173,6 +178,7 @@ void System::power() {
   if(cartridge.has_serial()) cpu.coprocessors.append(&serial);
 
   scheduler.init();
+  cheat.synchronize();
 
   input.update();
 //video.update();
@@ -214,6 +220,7 @@ void System::reset() {
   if(cartridge.has_serial()) cpu.coprocessors.append(&serial);
 
   scheduler.init();
+  cheat.synchronize();
 
   input.port_set_device(0, config().controller_port1);
   input.port_set_device(1, config().controller_port2);
@@ -27,12 +27,19 @@ public:
   serializer serialize();
   bool unserialize(serializer&);
 
+  //in-memory snapshots (eg for run-ahead): these reuse the serializer's buffer, and restore()
+  //skips the reset() done by unserialize(), so every thread must already be at a
+  //synchronization point (see runtosave()) when restoring
+  void snapshot(serializer&);
+  bool restore(serializer&);
+
   System();
 
 private:
   Interface *interface;
   bool runthreadtosave(cothread_t&);
 
+  bool serialize_header(serializer&);
   void serialize(serializer&);
   void serialize_all(serializer&);
   void serialize_init();
@@ -61,5 +68,5 @@ private:
 #include <interface/interface.hpp>
 #include <scheduler/scheduler.hpp>
 
-extern System system;
-extern Random random;
+extern threadlocal System system;
+extern threadlocal Random random;
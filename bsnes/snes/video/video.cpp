@@ -1,6 +1,6 @@
 #ifdef SYSTEM_CPP
 
-Video video;
+threadlocal Video video;
 
 const uint8_t Video::cursor[15 * 15] = {
   0,0,0,0,0,0,1,1,1,0,0,0,0,0,0,
@@ -20,37 +20,125 @@ const uint8_t Video::cursor[15 * 15] = {
   0,0,0,0,0,0,1,1,1,0,0,0,0,0,0,
 };
 
-void Video::draw_cursor(uint16_t color, int x, int y) {
-  uint16_t *data = (uint16_t*)ppu.output;
-  if(ppu.interlace() && ppu.field()) data += 512;
+//line y of the current field, in ppu.output or in the host buffer
+template<typename Pixel> Pixel* Video::line_data(unsigned y) {
+  bool field = ppu.interlace() && ppu.field();
+  if(format == Format::RGB555) return (Pixel*)(ppu.output + y * 1024 + field * 512);
+  return (Pixel*)(buffer + ((y - 1) * 2 + field) * pitch);
+}
+
+//ppu.output colors are 0rrrrrgggggbbbbb
+uint32_t Video::convert(uint16 color) const {
+  unsigned r = (color >> 10) & 31, g = (color >> 5) & 31, b = (color >> 0) & 31;
+  switch(format) { default:
+    case Format::RGB555: return color;
+    case Format::RGB565: return (r << 11) + (((g << 1) | (g >> 4)) << 5) + b;
+    case Format::XRGB8888: return (((r << 3) | (r >> 2)) << 16) + (((g << 3) | (g >> 2)) << 8) + ((b << 3) | (b >> 2));
+  }
+}
 
+void Video::convert_line(const uint16 *data, unsigned width) {
+  unsigned offset = data - ppu.output;
+  unsigned y = offset / 1024;
+  if(y == 0 || y >= 240) return;
+  uint8_t *row = buffer + ((y - 1) * 2 + (offset & 512 ? 1 : 0)) * pitch;
+
+  //each loop vectorizes
+  if(format == Format::RGB565) {
+    uint16_t *output = (uint16_t*)row;
+    for(unsigned x = 0; x < width; x++) {
+      uint16 color = data[x];
+      output[x] = ((color & 0x7fe0) << 1) + ((color >> 4) & 0x0020) + (color & 0x001f);
+    }
+  } else {
+    uint32_t *output = (uint32_t*)row;
+    for(unsigned x = 0; x < width; x++) {
+      uint32_t color = data[x];
+      uint32_t rgb = ((color & 0x7c00) << 9) + ((color & 0x03e0) << 6) + ((color & 0x001f) << 3);
+      output[x] = rgb + ((rgb >> 5) & 0x070707);
+    }
+  }
+}
+
+template<typename Pixel> void Video::draw_cursor(uint16_t color, int x, int y) {
   for(int cy = 0; cy < 15; cy++) {
     int vy = y + cy - 7;
     if(vy <= 0 || vy >= 240) continue;  //do not draw offscreen
 
+    Pixel *data = line_data<Pixel>(vy);
     bool hires = (line_width[vy] == 512);
     for(int cx = 0; cx < 15; cx++) {
       int vx = x + cx - 7;
       if(vx < 0 || vx >= 256) continue;  //do not draw offscreen
       uint8_t pixel = cursor[cy * 15 + cx];
       if(pixel == 0) continue;
-      uint16_t pixelcolor = (pixel == 1) ? 0 : color;
+      Pixel pixelcolor = convert((pixel == 1) ? 0 : color);
 
       if(hires == false) {
-        *((uint16_t*)data + vy * 1024 + vx) = pixelcolor;
+        data[vx] = pixelcolor;
       } else {
-        *((uint16_t*)data + vy * 1024 + vx * 2 + 0) = pixelcolor;
-        *((uint16_t*)data + vy * 1024 + vx * 2 + 1) = pixelcolor;
+        data[vx * 2 + 0] = pixelcolor;
+        data[vx * 2 + 1] = pixelcolor;
       }
     }
   }
 }
 
+//widen lowres lines of a frame that also has hires lines
+template<typename Pixel> void Video::normalize(unsigned height) {
+  Pixel line[256];
+  for(unsigned y = 1; y <= height; y++) {
+    if(line_width[y] == 512) continue;
+    Pixel *buffer = line_data<Pixel>(y);
+    //doubling from a copy, front to back, vectorizes into interleaving stores
+    memcpy(line, buffer, sizeof line);
+    for(unsigned x = 0; x < 256; x++) {
+      buffer[(x * 2) + 0] = buffer[(x * 2) + 1] = line[x];
+    }
+  }
+}
+
+void Video::set_enabled(bool enabled_) {
+  enabled = enabled_;
+}
+
+void Video::set_normalize(bool normalize_) {
+  normalize_enabled = normalize_;
+}
+
+unsigned Video::width(unsigned line) const {
+  return line < 239 ? line_width[line + 1] : 256;
+}
+
+void Video::set_format(Format format_, void *buffer_, unsigned pitch_) {
+  format = buffer_ ? format_ : Format::RGB555;
+  buffer = (uint8_t*)buffer_;
+  pitch = pitch_;
+}
+
 void Video::update() {
+  if(!enabled) {
+    frame_hires = false;
+    frame_interlace = false;
+    return;
+  }
+
+  bool host = format != Format::RGB555;
+  bool wide = format == Format::XRGB8888;
+
   switch(input.port[1].device) {
-    case Input::Device::SuperScope: draw_cursor(0x001f, input.port[1].superscope.x, input.port[1].superscope.y); break;
-    case Input::Device::Justifiers: draw_cursor(0x02e0, input.port[1].justifier.x2, input.port[1].justifier.y2); //fallthrough
-    case Input::Device::Justifier:  draw_cursor(0x001f, input.port[1].justifier.x1, input.port[1].justifier.y1); break;
+    case Input::Device::SuperScope:
+      wide ? draw_cursor<uint32_t>(0x001f, input.port[1].superscope.x, input.port[1].superscope.y)
+           : draw_cursor<uint16_t>(0x001f, input.port[1].superscope.x, input.port[1].superscope.y);
+      break;
+    case Input::Device::Justifiers:
+      wide ? draw_cursor<uint32_t>(0x02e0, input.port[1].justifier.x2, input.port[1].justifier.y2)
+           : draw_cursor<uint16_t>(0x02e0, input.port[1].justifier.x2, input.port[1].justifier.y2);
+      //fallthrough
+    case Input::Device::Justifier:
+      wide ? draw_cursor<uint32_t>(0x001f, input.port[1].justifier.x1, input.port[1].justifier.y1)
+           : draw_cursor<uint16_t>(0x001f, input.port[1].justifier.x1, input.port[1].justifier.y1);
+      break;
   }
 
   uint16_t *data = (uint16_t*)ppu.output;
@@ -60,15 +148,8 @@ void Video::update() {
 
   if(frame_hires) {
     width <<= 1;
-    if(!ppu.frame_skipped()) {
-      //normalize line widths
-      for(unsigned y = 0; y < 240; y++) {
-        if(line_width[y] == 512) continue;
-        uint16_t *buffer = data + y * 1024;
-        for(signed x = 255; x >= 0; x--) {
-          buffer[(x * 2) + 0] = buffer[(x * 2) + 1] = buffer[x];
-        }
-      }
+    if(normalize_enabled && !ppu.frame_skipped()) {
+      wide ? normalize<uint32_t>(height) : normalize<uint16_t>(height);
     }
   }
 
@@ -78,7 +159,7 @@ void Video::update() {
     height <<= 1;
   }
 
-  system.interface->video_refresh(ppu.output + 1024, width, height);
+  system.interface->video_refresh(host ? (const uint16_t*)buffer : ppu.output + 1024, width, height);
 
   frame_hires = false;
   frame_interlace = false;
@@ -100,4 +181,12 @@ void Video::init() {
   for(unsigned i = 0; i < 240; i++) line_width[i] = 256;
 }
 
+Video::Video() {
+  enabled = true;
+  normalize_enabled = true;
+  format = Format::RGB555;
+  buffer = 0;
+  pitch = 0;
+}
+
 #endif
@@ -1,5 +1,34 @@
 class Video {
+public:
+  enum class Format : unsigned { RGB555, RGB565, XRGB8888 };
+
+  //output can be suppressed, eg for frames that are emulated speculatively
+  void set_enabled(bool);
+
+  //RGB555 frames are passed from ppu.output; other formats are written to buffer (pitch in bytes)
+  //as the PPU finishes each line, line y of field f to row (y - 1) * 2 + f, and buffer is passed
+  //to video_refresh. progressive frames only use the even rows
+  void set_format(Format format, void *buffer = 0, unsigned pitch = 0);
+
+  //frames mixing 256 and 512 pixel lines are widened to 512 pixels per line unless disabled;
+  //lowres lines are then left 256 pixels wide, and width() reports the width of each line
+  void set_normalize(bool);
+  unsigned width(unsigned line) const;
+
+  //called by the PPU with every finished line of ppu.output
+  alwaysinline void line(const uint16 *data, unsigned width) {
+    if(format != Format::RGB555 && enabled) convert_line(data, width);
+  }
+
+  Video();
+
 private:
+  bool enabled;
+  bool normalize_enabled;
+  Format format;
+  uint8_t *buffer;
+  unsigned pitch;
+
   bool frame_hires;
   bool frame_interlace;
   unsigned line_width[240];
@@ -8,10 +37,15 @@ private:
   void scanline();
   void init();
 
+  void convert_line(const uint16 *data, unsigned width);
+  uint32_t convert(uint16 color) const;
+  template<typename Pixel> Pixel* line_data(unsigned y);
+  template<typename Pixel> void normalize(unsigned height);
+
   static const uint8_t cursor[15 * 15];
-  void draw_cursor(uint16_t color, int x, int y);
+  template<typename Pixel> void draw_cursor(uint16_t color, int x, int y);
 
   friend class System;
 };
 
-extern Video video;
+extern threadlocal Video video;
@@ -170,6 +170,7 @@ int Application::main(int &argc, char **argv) {
   connect(timer, SIGNAL(timeout()), this, SLOT(run()));
   timer->start(0);
   app->exec();
+  interface.stopRenderer();
 
   //QbWindow::close() saves window geometry for next run
   for(unsigned i = 0; i < windowList.size(); i++) {
@@ -204,7 +205,7 @@ void Application::run() {
   }
 
   if(SNES::cartridge.loaded() && !pause && !autopause && (!debug || debugrun)) {
-    SNES::system.run();
+    if(!state.runAhead()) SNES::system.run();
     #if defined(DEBUGGER)
     if(SNES::debugger.break_event != SNES::Debugger::BreakEvent::None) {
       debug = !SNES::debugger.log_without_break;
@@ -218,6 +219,7 @@ void Application::run() {
       pause = true;
     }
   } else {
+    interface.presentFrame();  //the last frame may still have been rendering
     usleep(1000);
     if (frameAdvance) {
       audio.clear();
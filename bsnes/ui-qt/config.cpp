@@ -25,6 +25,7 @@ Configuration::Configuration() {
   attach(snes_config.cpu.ntsc_frequency = 21477272, "cpu.ntscFrequency");
   attach(snes_config.cpu.pal_frequency  = 21281370, "cpu.palFrequency");
   attach(snes_config.cpu.wram_init_value =     0x55, "cpu.wramInitValue");
+  attach(snes_config.cpu.idle_skip       =    false, "cpu.idleSkip", "Fast-forward through WAI and polling loops");
 
   attach(snes_config.smp.ntsc_frequency = 24607104, "smp.ntscFrequency");
   attach(snes_config.smp.pal_frequency  = 24607104, "smp.palFrequency");
@@ -55,6 +56,9 @@ Configuration::Configuration() {
   attach(system.speedFastest = 200, "system.speedFastest");
   attach(system.autoSaveMemory = false, "system.autoSaveMemory", "Automatically save cartridge back-up RAM once every minute");
   attach(system.rewindEnabled  = false, "system.rewindEnabled", "Automatically save states periodically to allow auto-rewind support");
+  attach(system.rewindInterval = 1, "system.rewindInterval", "Frames between rewind snapshots");
+  attach(system.rewindMemory  = 32, "system.rewindMemory", "Memory budget for rewind snapshots, in megabytes");
+  attach(system.runAhead      = 0, "system.runAhead", "Frames to emulate ahead of the displayed one to hide input lag (0 = disabled)");
 
   attach(diskBrowser.useCommonDialogs = false, "diskBrowser.useCommonDialogs");
   attach(diskBrowser.showPanel = true, "diskBrowser.showPanel");
@@ -12,6 +12,9 @@ public:
     unsigned speedFastest;
     bool autoSaveMemory;
     bool rewindEnabled;
+    unsigned rewindInterval;
+    unsigned rewindMemory;
+    unsigned runAhead;
   } system;
 
   struct File {
@@ -4,7 +4,12 @@ namespace UserInterfaceStates {
 
 struct Rewind : HotkeyInput {
   void pressed() {
-    ::state.rewind();
+    //State::frame() steps back once per frame while held
+    ::state.rewinding = true;
+  }
+
+  void released() {
+    ::state.rewinding = false;
   }
 
   Rewind() : HotkeyInput("Rewind", "input.userInterface.states.rewind") {
@@ -34,22 +34,34 @@ void Interface::video_refresh(const uint16_t *data, unsigned width, unsigned hei
 
   width -= (cropLeft + cropRight);
   height -= (cropTop + cropBottom);
+  data += cropTop * (pitch >> 1) + cropLeft;
 
-  uint32_t *output;
-  unsigned outwidth, outheight, outpitch;
-  filter.size(outwidth, outheight, width, height);
+  if(!renderer) {
+    renderer = new Renderer;
+    renderer->start();
+  }
 
-  if(video.lock(output, outpitch, outwidth, outheight) == true) {
-    data += cropTop * (pitch >> 1) + cropLeft;
-    filter.render(output, outpitch, data, pitch, width, height);
-    video.unlock();
-    video.refresh();
+  //take a free frame, else replace the oldest one that has not been presented yet
+  frameLock.lock();
+  Frame *frame = oldest(Frame::State::Free);
+  if(!frame) frame = oldest(Frame::State::Pending);
+  if(!frame) frame = oldest(Frame::State::Ready);
+  frame->state = Frame::State::Writing;
+  frameLock.unlock();
 
-    if(saveScreenshot == true && config().video.unfilteredScreenshot == false) {
-      captureScreenshot(QImage((const unsigned char*)output, outwidth, outheight, outpitch, QImage::Format_RGB32));
-    }
+  for(unsigned y = 0; y < height; y++) {
+    memcpy(frame->input + y * 512, data + y * (pitch >> 1), width * sizeof(uint16_t));
   }
+  frame->width = width;
+  frame->height = height;
 
+  frameLock.lock();
+  frame->serial = ++frameSerial;
+  frame->state = Frame::State::Pending;
+  framePending.wakeOne();
+  frameLock.unlock();
+
+  presentFrame();
   state.frame();
 
   //frame counter
@@ -66,9 +78,114 @@ void Interface::video_refresh(const uint16_t *data, unsigned width, unsigned hei
   }
 }
 
-void Interface::audio_sample(uint16_t left, uint16_t right) {
-  if(config().audio.mute) left = right = 0;
-  audio.sample(left, right);
+void Interface::presentFrame() {
+  frameLock.lock();
+  Frame *frame = newest(Frame::State::Ready);
+  if(frame) frame->state = Frame::State::Presenting;
+  frameLock.unlock();
+  if(!frame) return;
+
+  uint32_t *output;
+  unsigned outpitch;
+  if(video.lock(output, outpitch, frame->outwidth, frame->outheight) == true) {
+    for(unsigned y = 0; y < frame->outheight; y++) {
+      memcpy((uint8_t*)output + y * outpitch, frame->output + y * frame->outwidth, frame->outwidth * sizeof(uint32_t));
+    }
+    video.unlock();
+    video.refresh();
+
+    if(saveScreenshot == true && config().video.unfilteredScreenshot == false) {
+      captureScreenshot(QImage((const unsigned char*)frame->output, frame->outwidth, frame->outheight,
+        frame->outwidth * sizeof(uint32_t), QImage::Format_RGB32));
+    }
+  }
+
+  frameLock.lock();
+  frame->state = Frame::State::Free;
+  frameLock.unlock();
+}
+
+//drop every frame not yet presented, eg when the video output is cleared
+void Interface::clearFrames() {
+  frameLock.lock();
+  while(newest(Frame::State::Rendering)) frameRendered.wait(&frameLock);
+  for(unsigned n = 0; n < 3; n++) frames[n].state = Frame::State::Free;
+  frameLock.unlock();
+}
+
+void Interface::stopRenderer() {
+  if(!renderer) return;
+  frameLock.lock();
+  rendererExit = true;
+  framePending.wakeOne();
+  frameLock.unlock();
+  renderer->wait();
+  delete renderer;
+  renderer = 0;
+}
+
+Interface::Frame* Interface::newest(Frame::State state) {
+  Frame *frame = 0;
+  for(unsigned n = 0; n < 3; n++) {
+    if(frames[n].state != state) continue;
+    if(!frame || frames[n].serial > frame->serial) frame = &frames[n];
+  }
+  return frame;
+}
+
+Interface::Frame* Interface::oldest(Frame::State state) {
+  Frame *frame = 0;
+  for(unsigned n = 0; n < 3; n++) {
+    if(frames[n].state != state) continue;
+    if(!frame || frames[n].serial < frame->serial) frame = &frames[n];
+  }
+  return frame;
+}
+
+void Interface::Renderer::run() {
+  interface.renderFrames();
+}
+
+void Interface::renderFrames() {
+  frameLock.lock();
+  while(rendererExit == false) {
+    Frame *frame = newest(Frame::State::Pending);
+    if(!frame) {
+      framePending.wait(&frameLock);
+      continue;
+    }
+    //older pending frames were superseded before they could be filtered
+    while(Frame *older = oldest(Frame::State::Pending)) {
+      if(older == frame) break;
+      older->state = Frame::State::Free;
+    }
+    frame->state = Frame::State::Rendering;
+    frameLock.unlock();
+
+    filterLock.lock();
+    filter.size(frame->outwidth, frame->outheight, frame->width, frame->height);
+    if(frame->outwidth * frame->outheight > frame->outsize) {
+      delete[] frame->output;
+      frame->outsize = frame->outwidth * frame->outheight;
+      frame->output = new uint32_t[frame->outsize];
+    }
+    filter.render(frame->output, frame->outwidth * sizeof(uint32_t), frame->input, 512 * sizeof(uint16_t), frame->width, frame->height);
+    filterLock.unlock();
+
+    frameLock.lock();
+    if(Frame *previous = newest(Frame::State::Ready)) previous->state = Frame::State::Free;
+    frame->state = Frame::State::Ready;
+    frameRendered.wakeAll();
+  }
+  frameLock.unlock();
+}
+
+void Interface::audio_sample_batch(const int16_t *data, unsigned frames) {
+  if(config().audio.mute) {
+    for(unsigned n = 0; n < frames; n++) audio.sample(0, 0);
+    return;
+  }
+  audio.sample_batch(data, frames);
 }
 
 void Interface::input_poll() {
@@ -121,4 +238,16 @@ void Interface::captureSPC() {
 
 Interface::Interface() {
   saveScreenshot = false;
+
+  for(unsigned n = 0; n < 3; n++) {
+    frames[n].state = Frame::State::Free;
+    frames[n].serial = 0;
+    frames[n].input = new uint16_t[512 * 480];
+    frames[n].width = frames[n].height = 0;
+    frames[n].output = 0;
+    frames[n].outwidth = frames[n].outheight = frames[n].outsize = 0;
+  }
+  frameSerial = 0;
+  rendererExit = false;
+  renderer = 0;
 }
@@ -2,7 +2,7 @@ class Interface : public SNES::Interface {
 public:
   void video_extras(uint16_t *data, unsigned width, unsigned height);
   void video_refresh(const uint16_t *data, unsigned width, unsigned height);
-  void audio_sample(uint16_t left, uint16_t right);
+  void audio_sample_batch(const int16_t *data, unsigned frames);
   void input_poll();
   int16_t input_poll(bool port, SNES::Input::Device device, unsigned index, unsigned id);
   void message(const string &text);
@@ -13,6 +13,39 @@ public:
   bool saveScreenshot;
   bool framesUpdated;
   unsigned framesExecuted;
+
+  //frames are filtered by a render thread while emulation continues, and presented
+  //from the main thread, which owns the video driver
+  void presentFrame();
+  void clearFrames();
+  void stopRenderer();
+  QMutex filterLock;  //held while a frame is filtered; take it to change filter settings
+
+private:
+  //triple buffer: video_refresh() fills a frame, the render thread filters it, presentFrame()
+  //shows it. only the newest frame of each stage is kept, so a slow filter drops frames
+  //instead of stalling emulation; with three frames, video_refresh() always finds one
+  struct Frame {
+    enum class State : unsigned { Free, Writing, Pending, Rendering, Ready, Presenting } state;
+    unsigned serial;
+    uint16_t *input;  //512 pixels per line
+    unsigned width, height;
+    uint32_t *output;  //outwidth pixels per line
+    unsigned outwidth, outheight, outsize;
+  } frames[3];
+  unsigned frameSerial;
+  bool rendererExit;
+  QMutex frameLock;
+  QWaitCondition framePending;
+  QWaitCondition frameRendered;
+
+  struct Renderer : QThread {
+    void run();
+  } *renderer;
+
+  Frame* newest(Frame::State);
+  Frame* oldest(Frame::State);
+  void renderFrames();
 };
 
 extern Interface interface;
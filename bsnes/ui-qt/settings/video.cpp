@@ -249,6 +249,7 @@ void VideoSettingsWindow::gammaAdjust(int value) {
 void VideoSettingsWindow::scanlineAdjust(int value) {
   config().video.scanlineAdjust = value * 5;
   syncUi();
+  QMutexLocker locker(&interface.filterLock);
   scanlineFilter.setIntensity(value * 5);
 }
 
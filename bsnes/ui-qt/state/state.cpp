@@ -1,6 +1,88 @@
 #include "../ui-base.hpp"
+#include <nall/crc32.hpp>
+#include <nall/lzss.hpp>
 State state;
 
+//rewind history deltas: the XOR of two equal-sized snapshots, stored as pairs of
+//varints (unchanged byte count, changed byte count) each followed by the changed bytes.
+//as XOR is its own inverse, applying a delta to either snapshot yields the other one.
+
+static uint8_t* writeVarint(uint8_t *p, unsigned n) {
+  while(n >= 0x80) *p++ = n | 0x80, n >>= 7;
+  *p++ = n;
+  return p;
+}
+
+static unsigned readVarint(const uint8_t *&p) {
+  unsigned n = 0;
+  for(unsigned shift = 0; ; shift += 7) {
+    n |= (*p & 0x7f) << shift;
+    if(!(*p++ & 0x80)) return n;
+  }
+}
+
+//base is updated to match data while encoding; output must hold size * 2 + 16 bytes
+static unsigned encodeDelta(uint8_t *output, uint8_t *base, const uint8_t *data, unsigned size) {
+  uint8_t *o = output;
+  unsigned i = 0;
+
+  while(i < size) {
+    unsigned skip = i;
+    while(i + 8 <= size && !memcmp(base + i, data + i, 8)) i += 8;
+    while(i < size && base[i] == data[i]) i++;
+    skip = i - skip;
+
+    //a changed span ends at the next run of eight unchanged bytes
+    unsigned start = i, same = 0;
+    while(i < size && same < 8) {
+      same = base[i] == data[i] ? same + 1 : 0;
+      i++;
+    }
+    i -= same;
+
+    o = writeVarint(o, skip);
+    o = writeVarint(o, i - start);
+    for(unsigned n = start; n < i; n++) {
+      *o++ = base[n] ^ data[n];
+      base[n] = data[n];
+    }
+  }
+
+  return o - output;
+}
+
+static void applyDelta(uint8_t *base, const uint8_t *delta, unsigned size) {
+  const uint8_t *end = delta + size;
+  unsigned i = 0;
+
+  while(delta < end) {
+    i += readVarint(delta);
+    unsigned length = readVarint(delta);
+    while(length--) base[i++] ^= *delta++;
+  }
+}
+
+//savestate files start with a 16-byte header: the 'BSTZ' signature, then the container version,
+//uncompressed size and CRC32 of the state (little-endian); the state follows, compressed with
+//nall::lzss. files from older versions hold the uncompressed state only.
+static unsigned readLong(const uint8_t *p) {
+  return p[0] << 0 | p[1] << 8 | p[2] << 16 | p[3] << 24;
+}
+
+void State::Writer::run() {
+  uint8_t *output;
+  unsigned length;
+  lzss::encode(output, length, state.data(), state.size());
+
+  fp.writem(0x4253545a, 4);  //'BSTZ'
+  fp.writel(1, 4);
+  fp.writel(state.size(), 4);
+  fp.writel(crc32_calculate(state.data(), state.size()), 4);
+  fp.write(output, length);
+  fp.close();
+  delete[] output;
+}
+
 bool State::save(unsigned slot) {
   if(!allowed()) {
     utility.showMessage("Cannot save state.");
@@ -8,14 +90,13 @@ bool State::save(unsigned slot) {
   }
 
   SNES::system.runtosave();
-  serializer state = SNES::system.serialize();
+  if(!writer) writer = new Writer;
+  writer->wait();  //the previous save may still be in progress
 
-  file fp;
-  bool result = false;
-  if(fp.open(name(slot), file::mode::write)) {
-    fp.write(state.data(), state.size());
-    fp.close();
-    result = true;
+  bool result = writer->fp.open(name(slot), file::mode::write);
+  if(result) {
+    writer->state = SNES::system.serialize();
+    writer->start();
   }
 
   if(result) {
@@ -32,16 +113,29 @@ bool State::load(unsigned slot) {
     return false;
   }
 
-  file fp;
+  if(writer) writer->wait();  //the slot may still be being written
+
+  filemap fp;
   bool result = false;
-  if(fp.open(name(slot), file::mode::read)) {
+  if(fp.open(name(slot), filemap::mode::read)) {
+    const uint8_t *data = fp.data();
     unsigned size = fp.size();
-    uint8_t *data = new uint8_t[size];
-    fp.read(data, size);
+    if(size >= 16 && !memcmp(data, "BSTZ", 4)) {
+      unsigned version = readLong(data + 4), length = readLong(data + 8), crc32 = readLong(data + 12);
+      if(version == 1 && length == SNES::system.serialize_size()) {
+        //decompress straight into the serializer's buffer
+        serializer state(length);
+        if(lzss::decode(state.data(), length, data + 16, size - 16)
+        && crc32_calculate(state.data(), length) == crc32) {
+          state.restart(serializer::Load);
+          result = SNES::system.unserialize(state);
+        }
+      }
+    } else {
+      serializer state(data, size);
+      result = SNES::system.unserialize(state);
+    }
     fp.close();
-    serializer state(data, size);
-    delete[] data;
-    result = SNES::system.unserialize(state);
   }
 
   if(result) {
@@ -54,22 +148,27 @@ bool State::load(unsigned slot) {
 }
 
 void State::frame() {
+  if(runningAhead) return;
   if(!allowed()) return;
   if(!config().system.rewindEnabled) return;
 
-  //if a full second has passed, automatically capture state
-  if(++frameCounter >= (SNES::system.region() == SNES::System::Region::NTSC ? 60 : 50)) {
+  if(rewinding) {
+    rewind();
+    return;
+  }
+
+  //automatically capture state every rewindInterval frames
+  if(++frameCounter >= max(1U, config().system.rewindInterval)) {
     frameCounter = 0;
-    historyIndex = (historyIndex + 1) % historySize;
-    historyCount = min(historyCount + 1, historySize);
     SNES::system.runtosave();
-    history[historyIndex] = SNES::system.serialize();
+    serializer state = SNES::system.serialize();
+    capture(state.data(), state.size());
   }
 }
 
 void State::resetHistory() {
-  historyIndex = 0;
-  historyCount = 0;
+  while(historyCount) dropOldest();
+  historyStateValid = false;
   frameCounter = 0;
 }
 
@@ -77,27 +176,140 @@ bool State::rewind() {
   if(!allowed()) return false;
   if(!config().system.rewindEnabled) return false;
 
-  if(historyCount == 0) return false;
-  serializer state(history[historyIndex].data(), history[historyIndex].size());
+  if(historyStateValid == false) return false;
+  serializer state(historyState, historyStateSize);
   bool result = SNES::system.unserialize(state);
-  historyIndex = (historyIndex + historySize - 1) % historySize;  //add historySize to prevent underflow
-  historyCount--;
+
+  //step the newest snapshot back to its predecessor
+  if(historyCount == 0) {
+    historyStateValid = false;
+  } else {
+    Delta &delta = history[(historyFirst + historyCount - 1) % historyCapacity];
+    applyDelta(historyState, delta.data, delta.size);
+    historyMemory -= delta.size;
+    delete[] delta.data;
+    historyCount--;
+  }
+  return result;
+}
+
+//run-ahead hides the game's own input lag: the real frame is emulated without output,
+//followed by runAhead frames with the same input of which only the last one is shown;
+//emulation then resumes from the real frame. returns false when the caller should
+//run the frame normally instead.
+bool State::runAhead() {
+  unsigned frames = config().system.runAhead;
+  if(!frames || rewinding || application.debug) return false;
+  if(!allowed()) return false;
+
+  SNES::video.set_enabled(false);
+  SNES::system.run();
+  SNES::video.set_enabled(true);
+  if(SNES::scheduler.exit_reason() != SNES::Scheduler::ExitReason::FrameEvent) return true;
+  frame();
+
+  SNES::system.runtosave();
+  SNES::system.snapshot(runAheadState);
+
+  runningAhead = true;
+  SNES::audio.set_enabled(false);
+  for(unsigned n = 1; n <= frames; n++) {
+    SNES::video.set_enabled(n == frames);
+    SNES::system.run();
+    if(SNES::scheduler.exit_reason() != SNES::Scheduler::ExitReason::FrameEvent) {
+      #if defined(DEBUGGER)
+      //the real frame will reach the same event again
+      SNES::debugger.break_event = SNES::Debugger::BreakEvent::None;
+      #endif
+      break;
+    }
+  }
+  runningAhead = false;
+
+  //the sync is still speculative, and may even cross another frame: keep its output muted
+  SNES::video.set_enabled(false);
+  SNES::system.runtosave();
+  SNES::system.restore(runAheadState);
+  SNES::video.set_enabled(true);
+  SNES::audio.set_enabled(true);
   return true;
 }
 
 State::State() {
   active = 0;
-  historySize = 120;
-  history = new serializer[historySize];
-  for(unsigned i = 0; i < historySize; i++) history[i] = 0;
+  rewinding = false;
+  historyState = 0;
+  historyStateSize = 0;
+  historyStateValid = false;
+  historyBuffer = 0;
+  history = 0;
+  historyCapacity = 0;
+  historyFirst = 0;
+  historyCount = 0;
+  historyMemory = 0;
+  frameCounter = 0;
+  writer = 0;
+  runningAhead = false;
 }
 
 State::~State() {
+  if(writer) {
+    writer->wait();
+    delete writer;
+  }
+  resetHistory();
   delete[] history;
+  delete[] historyBuffer;
+  delete[] historyState;
 }
 
 //
 
+void State::capture(const uint8_t *data, unsigned size) {
+  if(size != historyStateSize) {
+    resetHistory();
+    delete[] historyState;
+    delete[] historyBuffer;
+    historyState = new uint8_t[size];
+    historyBuffer = new uint8_t[size * 2 + 16];
+    historyStateSize = size;
+  }
+
+  if(historyStateValid == false) {
+    memcpy(historyState, data, size);
+    historyStateValid = true;
+    return;
+  }
+
+  if(historyCount == historyCapacity) {
+    unsigned capacity = max(256U, historyCapacity * 2);
+    Delta *ring = new Delta[capacity];
+    for(unsigned n = 0; n < historyCount; n++) ring[n] = history[(historyFirst + n) % historyCapacity];
+    delete[] history;
+    history = ring;
+    historyCapacity = capacity;
+    historyFirst = 0;
+  }
+
+  Delta &delta = history[(historyFirst + historyCount++) % historyCapacity];
+  delta.size = encodeDelta(historyBuffer, historyState, data, size);
+  delta.data = new uint8_t[delta.size];
+  memcpy(delta.data, historyBuffer, delta.size);
+  historyMemory += delta.size;
+
+  //the newest snapshot counts against the budget as well
+  uint64_t budget = (uint64_t)config().system.rewindMemory << 20;
+  while(historyCount && historyMemory + size > budget) dropOldest();
+}
+
+void State::dropOldest() {
+  Delta &delta = history[historyFirst];
+  historyMemory -= delta.size;
+  delete[] delta.data;
+  historyFirst = (historyFirst + 1) % historyCapacity;
+  historyCount--;
+}
+
 bool State::allowed() const {
   if(!SNES::cartridge.loaded() || !application.power) return false;
   if(movie.state != Movie::Inactive) return false;
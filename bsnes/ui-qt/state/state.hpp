@@ -7,17 +7,45 @@ public:
   void frame();
   void resetHistory();
   bool rewind();
+  bool rewinding;  //step back one snapshot every frame
+  bool runAhead();
 
   State();
   ~State();
 
 private:
-  serializer *history;
-  unsigned historySize;
-  unsigned historyIndex;
+  //rewind history: the newest snapshot is kept in full, each older one as a
+  //compressed XOR delta against its successor, held in a ring (oldest first)
+  struct Delta {
+    uint8_t *data;
+    unsigned size;
+  };
+  uint8_t *historyState;
+  unsigned historyStateSize;
+  bool historyStateValid;
+  uint8_t *historyBuffer;  //scratch space for encoding deltas
+  Delta *history;
+  unsigned historyCapacity;
+  unsigned historyFirst;
   unsigned historyCount;
+  unsigned historyMemory;
   unsigned frameCounter;
 
+  //savestate files are compressed and written out by a background thread,
+  //so that saving never stalls emulation
+  struct Writer : QThread {
+    file fp;
+    serializer state;
+    void run();
+  } *writer;
+
+  //run-ahead: state of the last emulated frame, restored after the speculative ones
+  serializer runAheadState;
+  bool runningAhead;
+
+  void capture(const uint8_t *data, unsigned size);
+  void dropOldest();
+
   bool allowed() const;
   string name(unsigned slot) const;
 };
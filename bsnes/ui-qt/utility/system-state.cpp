@@ -3,6 +3,7 @@ void Utility::modifySystemState(system_state_t systemState) {
   state.resetHistory();  //do not allow rewinding past a destructive system action
   movie.stop();  //movies cannot continue to record after destructive system actions
 
+  interface.clearFrames();
   video.clear();
   audio.clear();
 
@@ -38,6 +38,17 @@ namespace nall {
       return x | (x + 1);
     }
 
+    //first(0b1100) == 2; x must be non-zero
+    inline unsigned first(unsigned long long x) {
+      #if defined(__GNUC__)
+      return __builtin_ctzll(x);
+      #else
+      unsigned n = 0;
+      while(!(x & 1)) x >>= 1, n++;
+      return n;
+      #endif
+    }
+
     //round up to next highest single bit:
     //round(15) == 16, round(16) == 16, round(17) == 32
     inline unsigned round(unsigned x) {
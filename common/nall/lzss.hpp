@@ -1,15 +1,24 @@
 #ifndef NALL_LZSS_HPP
 #define NALL_LZSS_HPP
 
-#include <nall/array.hpp>
-#include <nall/new.hpp>
+#include <string.h>
 #include <nall/stdint.hpp>
 
 namespace nall {
+  //stream format: a flag byte precedes each group of eight items; a clear bit is a literal byte,
+  //a set bit a 16-bit little-endian pointer (low 12 bits: distance 1-4095, high 4 bits: length-3)
   class lzss {
   public:
+    enum : unsigned { Window = 4096, MaxLength = 15 + 3 };
+
     static bool encode(uint8_t *&output, unsigned &outlength, const uint8_t *input, unsigned inlength) {
-      output = new(zeromemory) uint8_t[inlength * 9 / 8 + 9];
+      output = new uint8_t[inlength * 9 / 8 + 9]();
+
+      //hash chains over the window: candidates sharing the next three bytes, newest first
+      enum : unsigned { HashSize = 8192, ChainLimit = 64 };
+      signed *head = new signed[HashSize];
+      signed *prev = new signed[Window];
+      for(unsigned n = 0; n < HashSize; n++) head[n] = -1;
 
       unsigned i = 0, o = 0;
       while(i < inlength) {
@@ -17,42 +26,58 @@ namespace nall {
         uint8_t flag = 0x00;
 
         for(unsigned b = 0; b < 8 && i < inlength; b++) {
-          unsigned longest = 0, pointer;
-          for(unsigned index = 1; index < 4096; index++) {
-            unsigned count = 0;
-            while(true) {
-              if(count >= 15 + 3) break;                               //verify pattern match is not longer than max length
-              if(i + count >= inlength) break;                         //verify pattern match does not read past end of input
-              if(i + count < index) break;                             //verify read is not before start of input
-              if(input[i + count] != input[i + count - index]) break;  //verify pattern still matches
-              count++;
-            }
+          unsigned longest = 0, pointer = 0;
+          if(i + 3 <= inlength) {
+            signed candidate = head[hash(input + i)];
+            for(unsigned chain = 0; chain < ChainLimit && candidate >= 0; chain++) {
+              unsigned index = i - candidate;
+              if(index >= Window) break;
+
+              unsigned count = 0;
+              while(count < MaxLength && i + count < inlength && input[i + count] == input[candidate + count]) count++;
+              if(count > longest) {
+                longest = count;
+                pointer = index;
+                if(longest == MaxLength) break;
+              }
 
-            if(count > longest) {
-              longest = count;
-              pointer = index;
+              signed next = prev[candidate & (Window - 1)];
+              if(next >= candidate) break;  //slot was reused by a newer position
+              candidate = next;
             }
           }
 
-          if(longest < 3) output[o++] = input[i++];
+          unsigned length = 1;
+          if(longest < 3) output[o++] = input[i];
           else {
             flag |= 1 << b;
             uint16_t x = ((longest - 3) << 12) + pointer;
             output[o++] = x;
             output[o++] = x >> 8;
-            i += longest;
+            length = longest;
+          }
+
+          while(length--) {
+            if(i + 3 <= inlength) {
+              unsigned h = hash(input + i);
+              prev[i & (Window - 1)] = head[h];
+              head[h] = i;
+            }
+            i++;
           }
         }
 
         output[flagoffset] = flag;
       }
 
+      delete[] head;
+      delete[] prev;
       outlength = o;
       return true;
     }
 
     static bool decode(uint8_t *&output, const uint8_t *input, unsigned length) {
-      output = new(zeromemory) uint8_t[length];
+      output = new uint8_t[length]();
 
       unsigned i = 0, o = 0;
       while(o < length) {
@@ -75,6 +100,39 @@ namespace nall {
 
       return true;
     }
+
+    //decodes into a caller-supplied buffer of exactly length bytes; fails on truncated or corrupt input
+    static bool decode(uint8_t *output, unsigned length, const uint8_t *input, unsigned inlength) {
+      unsigned i = 0, o = 0;
+      while(o < length) {
+        if(i >= inlength) return false;
+        uint8_t flag = input[i++];
+
+        for(unsigned b = 0; b < 8 && o < length; b++) {
+          if(!(flag & (1 << b))) {
+            if(i >= inlength) return false;
+            output[o++] = input[i++];
+          } else {
+            if(i + 2 > inlength) return false;
+            uint16_t offset = input[i++];
+            offset += input[i++] << 8;
+            unsigned lookuplength = (offset >> 12) + 3;
+            offset &= 4095;
+            if(offset == 0 || offset > o) return false;
+            for(unsigned index = 0; index < lookuplength && o < length; index++, o++) {
+              output[o] = output[o - offset];
+            }
+          }
+        }
+      }
+
+      return true;
+    }
+
+  private:
+    static unsigned hash(const uint8_t *p) {
+      return ((p[0] << 8) ^ (p[1] << 4) ^ p[2]) * 2654435761u >> 19;
+    }
   };
 }
 
@@ -61,6 +61,12 @@ namespace nall {
       return event;
     }
 
+    //ticks remaining before the next event fires
+    unsigned remaining() const {
+      if(heapsize == 0) return std::numeric_limits<unsigned>::max() >> 1;
+      return heap[0].counter - basecounter;
+    }
+
     void reset() {
       basecounter = 0;
       heapsize = 0;
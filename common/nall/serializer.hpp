@@ -30,6 +30,11 @@ namespace nall {
       return idata;
     }
 
+    //direct access to the buffer, eg to decompress a state into it before loading
+    uint8_t* data() {
+      return idata;
+    }
+
     unsigned size() const {
       return isize;
     }
@@ -38,6 +43,12 @@ namespace nall {
       return icapacity;
     }
 
+    //start over at the beginning of the existing buffer, eg to load back what was just saved
+    void restart(mode_t mode) {
+      imode = mode;
+      isize = 0;
+    }
+
     template<typename T> void floatingpoint(T &value) {
       enum { size = sizeof(T) };
       //this is rather dangerous, and not cross-platform safe;
@@ -58,7 +69,7 @@ namespace nall {
         for(unsigned n = 0; n < size; n++) idata[isize++] = value >> (n << 3);
       } else if(imode == Load) {
         value = 0;
-        for(unsigned n = 0; n < size; n++) value |= idata[isize++] << (n << 3);
+        for(unsigned n = 0; n < size; n++) value |= (T)idata[isize++] << (n << 3);
       } else if(imode == Size) {
         isize += size;
       }
@@ -66,11 +77,11 @@ namespace nall {
 
     template<typename T> void array(T &array) {
       enum { size = sizeof(T) / sizeof(typename std::remove_extent<T>::type) };
-      for(unsigned n = 0; n < size; n++) integer(array[n]);
+      elements(&array[0], size);
     }
 
     template<typename T> void array(T array, unsigned size) {
-      for(unsigned n = 0; n < size; n++) integer(array[n]);
+      elements(&array[0], size);
     }
 
     //copy
@@ -135,6 +146,17 @@ namespace nall {
     }
 
   private:
+    //byte arrays (RAM, VRAM, ...) make up most of any state: copy those as one block
+    template<typename T> void elements(T *array, unsigned size) {
+      if(std::is_integral<T>::value && !std::is_same<bool, T>::value && sizeof(T) == 1) {
+        if(imode == Save) memcpy(idata + isize, array, size);
+        else if(imode == Load) memcpy(array, idata + isize, size);
+        isize += size;
+      } else {
+        for(unsigned n = 0; n < size; n++) integer(array[n]);
+      }
+    }
+
     mode_t imode;
     uint8_t *idata;
     unsigned isize;
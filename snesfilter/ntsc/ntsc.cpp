@@ -29,6 +29,13 @@ void NTSCFilter::render(
 ) {
   if(!ntsc) return;
 
+  setupLock.lock();
+  if(setupChanged) {
+    setupChanged = false;
+    initialize();
+  }
+  setupLock.unlock();
+
   pitch >>= 1;
   outpitch >>= 2;
 
@@ -213,9 +220,11 @@ QWidget* NTSCFilter::settings() {
     controlLayout->addWidget(ok);
 
     blockSignals = true;
+    setupLock.lock();
     loadSettingsFromConfig();
+    setupChanged = true;
+    setupLock.unlock();
     syncUiToSettings();
-    initialize();
 
     connect(hueSlider, SIGNAL(valueChanged(int)), this, SLOT(syncSettingsToUi()));
     connect(saturationSlider, SIGNAL(valueChanged(int)), this, SLOT(syncSettingsToUi()));
@@ -332,46 +341,47 @@ void NTSCFilter::syncSettingsToUi() {
 
   mergeFields = mergeFieldsBox->isChecked();
 
+  setupLock.lock();
   loadSettingsFromConfig();
+  setupChanged = true;
+  setupLock.unlock();
+  syncUiToSettings();
+}
+
+void NTSCFilter::changeSetup(const snes_ntsc_setup_t &setup_) {
+  setupLock.lock();
+  setup = setup_;
+  setupChanged = true;
+  setupLock.unlock();
   syncUiToSettings();
-  initialize();
 }
 
 void NTSCFilter::setRfPreset() {
   static snes_ntsc_setup_t defaults;
-  setup = defaults;
-  syncUiToSettings();
-  initialize();
+  changeSetup(defaults);
 }
 
 void NTSCFilter::setCompositePreset() {
-  setup = snes_ntsc_composite;
-  syncUiToSettings();
-  initialize();
+  changeSetup(snes_ntsc_composite);
 }
 
 void NTSCFilter::setSvideoPreset() {
-  setup = snes_ntsc_svideo;
-  syncUiToSettings();
-  initialize();
+  changeSetup(snes_ntsc_svideo);
 }
 
 void NTSCFilter::setRgbPreset() {
-  setup = snes_ntsc_rgb;
-  syncUiToSettings();
-  initialize();
+  changeSetup(snes_ntsc_rgb);
 }
 
 void NTSCFilter::setMonoPreset() {
-  setup = snes_ntsc_monochrome;
-  syncUiToSettings();
-  initialize();
+  changeSetup(snes_ntsc_monochrome);
 }
 
 NTSCFilter::NTSCFilter() : widget(0) {
   ntsc = (snes_ntsc_t*)malloc(sizeof *ntsc);
   static snes_ntsc_setup_t defaults;
   setup = defaults;
+  setupChanged = false;
   initialize();
 }
 
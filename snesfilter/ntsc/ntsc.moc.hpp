@@ -14,6 +14,7 @@ private:
   void initialize();
   void loadSettingsFromConfig();
   void syncUiToSettings();
+  void changeSetup(const snes_ntsc_setup_t&);
 
 private slots:
   void syncSettingsToUi();
@@ -76,6 +77,11 @@ private:
   snes_ntsc_setup_t setup;
   int burst, burst_toggle;
 
+  //the settings window edits setup while render() runs on the renderer thread:
+  //edits are only flagged, and render() rebuilds the tables before its next frame
+  QMutex setupLock;
+  bool setupChanged;
+
   //settings
   double hue;
   double saturation;